@@ -1,7 +1,7 @@
 #
 # NNLV project file
 #
-QT      += core gui widgets charts xml xmlpatterns
+QT      += core gui widgets charts concurrent xml xmlpatterns
 
 CONFIG  += c++11
 CONFIG(release, debug|release):DEFINES += QT_NO_DEBUG_OUTPUT
@@ -40,19 +40,24 @@ SOURCES += main.cpp \
         helpbrowser.cpp \
         iconlabel.cpp \
         kmeansclustering.cpp \
+        kohonenconnectionsitem.cpp \
         kohonencreatenetworkwidget.cpp \
         kohoneninputlayer.cpp \
         kohoneninputneuron.cpp \
         kohonenlayer.cpp \
+        kohonenmapitem.cpp \
         kohonennetwork.cpp \
         kohonennetworkwizardpage.cpp \
         kohonenoutputlayer.cpp \
         kohonenoutputneuron.cpp \
+        kohonenschedule.cpp \
         kohonentrainingoptionsdialog.cpp \
         kohonenviewwidget.cpp \
         kohonenweightchartview.cpp \
         kohonenweightchartwidget.cpp \
+        leastsquares.cpp \
         maindockwidget.cpp \
+        mlpactivationkernels.cpp \
         mlpbiasneuron.cpp \
         mlpcreatenetworkwidget.cpp \
         mlphiddenlayer.cpp \
@@ -78,14 +83,18 @@ SOURCES += main.cpp \
         networkneuron.cpp \
         networkneurondialog.cpp \
         networkneurondialogspinbox.cpp \
+        networkoptimizer.cpp \
         networkstatusnumberlabel.cpp \
         networkstatuswidget.cpp \
+        networktrainingthread.cpp \
         networkviewwidget.cpp \
         networkvisualwidget.cpp \
+        networkweightmatrix.cpp \
         networkwizard.cpp \
         networkwizardmainpage.cpp \
         networkwizardpage.cpp \
         optionsdialog.cpp \
+        precisionbenchmark.cpp \
         rbfbiasneuron.cpp \
         rbfcreatenetworkwidget.cpp \
         rbfhiddenlayer.cpp \
@@ -132,6 +141,7 @@ SOURCES += main.cpp \
         trainingtabledialog.cpp \
         trainingtablemodel.cpp \
         utilities.cpp \
+        vectorkernels.cpp \
         vectorutilities.cpp \
         xmlmessagehandler.cpp \
         xmlworker.cpp
@@ -156,22 +166,27 @@ HEADERS += mainwindow.h \
         helpbrowser.h \
         iconlabel.h \
         kmeansclustering.h \
+        kohonenconnectionsitem.h \
         kohonencreatenetworkwidget.h \
         kohoneninputlayer.h \
         kohoneninputneuron.h \
         kohonenlayer.h \
+        kohonenmapitem.h \
         kohonennetworkdefaults.h \
         kohonennetwork.h \
         kohonennetworklimits.h \
         kohonennetworkwizardpage.h \
         kohonenoutputlayer.h \
         kohonenoutputneuron.h \
+        kohonenschedule.h \
         kohonentrainingoptionsdialog.h \
         kohonenviewwidget.h \
         kohonenweightchartview.h \
         kohonenweightchartwidget.h \
+        leastsquares.h \
         maindockwidget.h \
         mlpactivation.h \
+        mlpactivationkernels.h \
         mlpbiasneuron.h \
         mlpcreatenetworkwidget.h \
         mlphiddenlayer.h \
@@ -203,14 +218,20 @@ HEADERS += mainwindow.h \
         networkneurondialogspinbox.h \
         networkneuron.h \
         networkneuroninfo.h \
+        networkoptimizer.h \
         networkstatusnumberlabel.h \
+        networksnapshot.h \
         networkstatuswidget.h \
+        networktrainingthread.h \
         networkviewwidget.h \
         networkvisualwidget.h \
+        networkweightmatrix.h \
         networkwizard.h \
+        networkworkspace.h \
         networkwizardmainpage.h \
         networkwizardpage.h \
         optionsdialog.h \
+        precisionbenchmark.h \
         program.h \
         rbfbiasneuron.h \
         rbfcreatenetworkwidget.h \
@@ -261,6 +282,7 @@ HEADERS += mainwindow.h \
         trainingtabledialog.h \
         trainingtablemodel.h \
         utilities.h \
+        vectorkernels.h \
         vectorutilities.h \
         version.h \
         xmlmessagehandler.h \
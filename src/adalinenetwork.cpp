@@ -19,7 +19,10 @@
  */
 #include "adalinenetwork.h"
 
+#include <QMutexLocker>
+
 #include "graphicsutilities.h"
+#include "leastsquares.h"
 
 AdalineNetwork::AdalineNetwork(const NetworkInfo::Map& map, QObject* parent) :
     SupervisedNetwork(map, parent)
@@ -38,6 +41,7 @@ AdalineNetwork::AdalineNetwork(const NetworkInfo::Map& map, QObject* parent) :
     int outputCount = m_infoMap.value(NetworkInfo::Key::OutputNeuronCount).toInt();
     m_outputLayer = new AdalineOutputLayer(outputCount, this);
     m_outputLayer->setLearningRate(learningRate());
+    m_outputLayer->setOptimizer(optimizer());
     addLayer(m_outputLayer);
 
     m_inputLayer->connectTo(m_outputLayer);
@@ -59,6 +63,7 @@ AdalineNetwork::AdalineNetwork(const SavedNetwork& savedNetwork, QObject* parent
 
     m_outputLayer = new AdalineOutputLayer(savedLayers.at(1), this);
     m_outputLayer->setLearningRate(learningRate());
+    m_outputLayer->setOptimizer(optimizer());
     addLayer(m_outputLayer);
 
     m_inputLayer->connectTo(m_outputLayer);
@@ -109,13 +114,30 @@ void AdalineNetwork::init()
     });
 
     connect(this, &Network::infoChanged, this, [this] {
+        QMutexLocker locker(&trainingMutex());
         m_outputLayer->setLearningRate(learningRate());
+        m_outputLayer->setOptimizer(optimizer());
     });
 }
 
-QVector<double> AdalineNetwork::compute(const QVector<double>& input) const
+void AdalineNetwork::compute(const double* input, double* output, NetworkWorkspace& workspace) const
+{
+    Q_UNUSED(workspace);
+    m_outputLayer->computeInto(input, output);
+}
+
+void AdalineNetwork::computeBatch(const double* inputs, int count, double* outputs,
+                                  NetworkWorkspace& workspace) const
+{
+    Q_UNUSED(workspace);
+    m_outputLayer->computeBatchInto(inputs, count, outputs);
+}
+
+void AdalineNetwork::computeBatch(const float* inputs, int count, float* outputs,
+                                  NetworkWorkspace& workspace) const
 {
-    return m_outputLayer->compute(input);
+    Q_UNUSED(workspace);
+    m_outputLayer->computeBatchInto(inputs, count, outputs);
 }
 
 void AdalineNetwork::computeAndSet(const QVector<double>& input)
@@ -124,6 +146,33 @@ void AdalineNetwork::computeAndSet(const QVector<double>& input)
     m_outputLayer->computeAndSet(input);
 }
 
+void AdalineNetwork::prepareTraining()
+{
+    m_outputLayer->resetOptimizer();
+    if (trainingMethod() == NetworkInfo::TrainingMethod::Solve)
+        solveOutputWeights();
+}
+
+//
+// Compute the weights with the least squares error over the training set at once
+// and stop the training
+//
+void AdalineNetwork::solveOutputWeights()
+{
+    const auto& weights = m_outputLayer->inWeights();
+    LeastSquares equations(weights.columns(), weights.rows());
+
+    for (const auto& sample : trainingTableModel()->store().samples())
+        equations.addSample(sample.inputs().constData(), sample.outputs().constData());
+
+    if (m_outputLayer->solveWeights(equations, ridgeRegularization()))
+        requestTrainingStop(StopTrainingReason::WeightsSolved);
+    else {
+        emit statusMessage(tr("The output weights cannot be solved"));
+        requestTrainingStop(StopTrainingReason::UserRequested);
+    }
+}
+
 void AdalineNetwork::train(const TrainingSample& sample)
 {
     m_inputLayer->setValues(sample.inputs());
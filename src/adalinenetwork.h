@@ -33,13 +33,23 @@ public:
     explicit AdalineNetwork(const NetworkInfo::Map& map, QObject* parent = nullptr);
     explicit AdalineNetwork(const SavedNetwork& savedNetwork, QObject* parent = nullptr);
 
-    QVector<double> compute(const QVector<double>& input) const override;
+    using Network::compute;
+    using Network::computeBatch;
+    void compute(const double* input, double* output, NetworkWorkspace& workspace) const override;
+    void computeBatch(const double* inputs, int count, double* outputs,
+                      NetworkWorkspace& workspace) const override;
+    void computeBatch(const float* inputs, int count, float* outputs,
+                      NetworkWorkspace& workspace) const override;
     void computeAndSet(const QVector<double>& input) override;
     void train(const TrainingSample& sample) override;
     void updateScenePosition() override;
 
+protected:
+    void prepareTraining() override;
+
 private:
     void init();
+    void solveOutputWeights();
 
     AdalineInputLayer* m_inputLayer;
     AdalineOutputLayer* m_outputLayer;
@@ -37,3 +37,11 @@ AdalineOutputLayer::AdalineOutputLayer(SavedNetworkLayer* layer, Network* parent
     for (auto* savedNeuron : layer->savedNeurons())
         addNeuron(new AdalineOutputNeuron(savedNeuron, this));
 }
+
+//
+// Adaline output is the linear combination of the inputs
+//
+double AdalineOutputLayer::activate(double value) const
+{
+    return value;
+}
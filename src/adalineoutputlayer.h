@@ -30,4 +30,7 @@ class AdalineOutputLayer : public SLPOutputLayer
 public:
     explicit AdalineOutputLayer(int neurons, Network* parent);
     explicit AdalineOutputLayer(SavedNetworkLayer* layer, Network* parent);
+
+protected:
+    double activate(double value) const override;
 };
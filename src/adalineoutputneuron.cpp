@@ -28,32 +28,3 @@ AdalineOutputNeuron::AdalineOutputNeuron(SavedNetworkNeuron* savedNeuron, Networ
     SLPOutputNeuron(savedNeuron, parent)
 {
 }
-
-double AdalineOutputNeuron::compute(const QVector<double>& input) const
-{
-    double value = inConnection(0)->weight();
-    for (int i = 1; i < input.size(); i++)
-        value += input.at(i - 1) * inConnection(i)->weight();
-
-    return value;
-}
-
-void AdalineOutputNeuron::train(const QVector<double>& input, int target)
-{
-    double value = 0.0;
-    const auto& connections = inConnections();
-    for (const auto* conn : connections)
-        value += conn->neuron1()->value() * conn->weight();
-
-    double rate = learningRate();
-    for (int i = 0; i < inConnectionCount(); i++) {
-        auto* conn = inConnection(i);
-
-        double weight = rate * (value - target);
-        if (i > 0)
-            weight *= input[i - 1];
-
-        conn->setWeight(conn->weight() - weight);
-    }
-    setValue(value);
-}
@@ -29,7 +29,4 @@ class AdalineOutputNeuron : public SLPOutputNeuron
 public:
     explicit AdalineOutputNeuron(NetworkLayer* parent);
     explicit AdalineOutputNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent);
-
-    double compute(const QVector<double>& input) const override;
-    void train(const QVector<double>& input, int target) override;
 };
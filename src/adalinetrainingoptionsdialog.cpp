@@ -20,6 +20,8 @@
 #include "adalinetrainingoptionsdialog.h"
 #include "ui_adalinetrainingoptionsdialog.h"
 
+#include "supervisednetwork.h"
+
 AdalineTrainingOptionsDialog::AdalineTrainingOptionsDialog(Network* network, QWidget *parent) :
     QDialog(parent),
     ui(new Ui::AdalineTrainingOptionsDialog),
@@ -37,9 +39,19 @@ AdalineTrainingOptionsDialog::~AdalineTrainingOptionsDialog()
 void AdalineTrainingOptionsDialog::init()
 {
     const auto& map = m_network->infoMap();
+    auto* network = qobject_cast<SupervisedNetwork*>(m_network);
+
+    ui->comboBoxTrainingMethod->addItems(NetworkInfo::trainingMethodStringList());
+    ui->comboBoxTrainingMethod->setCurrentIndex(
+                NetworkInfo::trainingMethodToIndex(network->trainingMethod()));
+    on_comboBoxTrainingMethod_currentIndexChanged(ui->comboBoxTrainingMethod->currentIndex());
+    ui->editRidgeRegularization->setValue(network->ridgeRegularization());
 
     ui->editLearningRate->setValue(map[NetworkInfo::Key::LearningRate].toDouble());
 
+    ui->comboBoxOptimizer->addItems(NetworkInfo::optimizerStringList());
+    ui->comboBoxOptimizer->setCurrentIndex(NetworkInfo::optimizerToIndex(network->optimizer()));
+
     if (map.contains(NetworkInfo::Key::MaxEpochs)) {
         ui->checkBoxMaxEpochs->setChecked(true);
         ui->editMaxEpochs->setEnabled(true);
@@ -59,11 +71,27 @@ void AdalineTrainingOptionsDialog::init()
     ui->comboBoxSampleSelectionOrder->addItems(NetworkInfo::sampleSelectionOrderStringList());
     if (map.contains(NetworkInfo::Key::SampleSelectionOrder))
         ui->comboBoxSampleSelectionOrder->setCurrentIndex(NetworkInfo::sampleSelectionOrderIndexFromMap(map));
+
+    ui->comboBoxEvaluationMode->addItems(NetworkInfo::evaluationModeStringList());
+    ui->comboBoxEvaluationMode->setCurrentIndex(
+                NetworkInfo::evaluationModeToIndex(m_network->evaluationMode()));
+    ui->editEvaluationInterval->setValue(m_network->evaluationInterval());
+
+    ui->comboBoxEvaluationPrecision->addItems(NetworkInfo::evaluationPrecisionStringList());
+    ui->comboBoxEvaluationPrecision->setCurrentIndex(
+                NetworkInfo::evaluationPrecisionToIndex(m_network->evaluationPrecision()));
 }
 
 void AdalineTrainingOptionsDialog::accept()
 {
+    auto* network = qobject_cast<SupervisedNetwork*>(m_network);
+
+    network->setTrainingMethod(
+                NetworkInfo::trainingMethodFromIndex(
+                    ui->comboBoxTrainingMethod->currentIndex()));
+    network->setRidgeRegularization(ui->editRidgeRegularization->value());
     m_network->setLearningRate(ui->editLearningRate->value());
+    network->setOptimizer(NetworkInfo::optimizerFromIndex(ui->comboBoxOptimizer->currentIndex()));
 
     if (ui->checkBoxMaxEpochs->isChecked())
         m_network->setMaxTrainingEpochs(ui->editMaxEpochs->value());
@@ -76,6 +104,14 @@ void AdalineTrainingOptionsDialog::accept()
                 NetworkInfo::sampleSelectionOrderFromIndex(
                     ui->comboBoxSampleSelectionOrder->currentIndex()));
 
+    m_network->setEvaluationMode(
+                NetworkInfo::evaluationModeFromIndex(
+                    ui->comboBoxEvaluationMode->currentIndex()));
+    m_network->setEvaluationInterval(ui->editEvaluationInterval->value());
+    m_network->setEvaluationPrecision(
+                NetworkInfo::evaluationPrecisionFromIndex(
+                    ui->comboBoxEvaluationPrecision->currentIndex()));
+
     if (ui->checkBoxStopError->isChecked())
         m_network->setStopError(ui->editStopError->value());
     else
@@ -93,3 +129,25 @@ void AdalineTrainingOptionsDialog::on_checkBoxStopError_clicked(bool checked)
 {
     ui->editStopError->setEnabled(checked);
 }
+
+void AdalineTrainingOptionsDialog::on_comboBoxEvaluationMode_currentIndexChanged(int index)
+{
+    //
+    // The interval is only used by the interval evaluation mode
+    //
+    ui->editEvaluationInterval->setEnabled(
+                NetworkInfo::evaluationModeFromIndex(index) == NetworkInfo::EvaluationMode::Interval);
+}
+
+void AdalineTrainingOptionsDialog::on_comboBoxTrainingMethod_currentIndexChanged(int index)
+{
+    //
+    // The learning rate and the optimizer are only used by the least mean squares
+    // method and the regularization only by the solved weights
+    //
+    bool solve = NetworkInfo::trainingMethodFromIndex(index) == NetworkInfo::TrainingMethod::Solve;
+
+    ui->editLearningRate->setEnabled(!solve);
+    ui->comboBoxOptimizer->setEnabled(!solve);
+    ui->editRidgeRegularization->setEnabled(solve);
+}
@@ -41,6 +41,8 @@ public:
 private slots:
     void on_checkBoxMaxEpochs_clicked(bool checked);
     void on_checkBoxStopError_clicked(bool checked);
+    void on_comboBoxEvaluationMode_currentIndexChanged(int index);
+    void on_comboBoxTrainingMethod_currentIndexChanged(int index);
 
 private:
     void init();
@@ -33,6 +33,11 @@ QColor Colors::colorKohonenOutputNeuronValue(double neighborhoodValue)
                            255 * neighborhoodValue);
 }
 
+QColor Colors::colorKohonenMapDistance(double distance)
+{
+    return QColor::fromHsv(0, 0, 255 * (1 - qBound(0.0, distance, 1.0)));
+}
+
 QColor Colors::colorChartSeries(int index)
 {
     constexpr int total = 10;
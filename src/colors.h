@@ -52,6 +52,11 @@ namespace Colors {
     const QColor ColorKohonenOutputInitial = Qt::black;
     const QColor ColorKohonenOutputColor = QColor::fromHsv(48, 255, 255);
     //
+    // Connections of a large Kohonen map drawn as a whole
+    //
+    const QColor ColorKohonenConnections = QColor(0, 0, 0, 96);
+    const QColor ColorKohonenConnectionsFill = QColor(0, 0, 0, 16);
+    //
     // Neuron mark in a weight chart
     //
     const QColor ColorWeightChartNeuron = Qt::red;
@@ -75,6 +80,12 @@ namespace Colors {
     //
     QColor colorKohonenOutputNeuronValue(double neighborhoodValue);
 
+    //
+    // Calculate color of a Kohonen map cell from the distance to the neighbors
+    // in the range [0, 1], distant cells are dark
+    //
+    QColor colorKohonenMapDistance(double distance);
+
     //
     // Return color for a QtChart series with the given index
     //
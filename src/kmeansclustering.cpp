@@ -20,10 +20,14 @@
 #include "kmeansclustering.h"
 
 #include <cmath>
+#include <cstring>
 #include <utility>
-#include <QApplication>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
 
-#include "vectorutilities.h"
+#include "vectorkernels.h"
 
 KMeansClustering::KMeansClustering(QObject* parent) :
     QObject(parent),
@@ -33,42 +37,111 @@ KMeansClustering::KMeansClustering(QObject* parent) :
 
 KMeansClustering::KMeansClustering(const QVector<TrainingSample>& samples, QObject* parent) :
     QObject(parent),
-    m_generator(std::random_device{}()),
-    m_samples(samples)
+    m_generator(std::random_device{}())
 {
+    setTrainingSamples(samples);
 }
 
 void KMeansClustering::setTrainingSamples(const QVector<TrainingSample>& samples)
 {
-    m_samples = samples;
+    m_sampleCount = samples.size();
+    m_columns = samples.isEmpty() ? 0 : samples.first().inputs().size();
+
+    m_inputs.resize(m_sampleCount * m_columns);
+    for (int i = 0; i < m_sampleCount; i++) {
+        const auto& inputs = samples.at(i).inputs();
+        Q_ASSERT(inputs.size() == m_columns);
+        std::memcpy(m_inputs.data() + i * m_columns, inputs.constData(), m_columns * sizeof(double));
+    }
 }
 
-void KMeansClustering::doClustering(int clusterCount)
+//
+// Cluster the samples, the algorithm is run options.restarts times from different
+// initial centers and the result with the lowest inertia is kept.
+//
+// The runs are performed in parallel, this thread takes the first one and reports
+// its progress. The clustering stops early and false is returned as soon as the
+// optional cancellation function returns true, no clusters are available then.
+//
+bool KMeansClustering::doClustering(int clusterCount, const Options& options,
+                                    const std::function<bool()>& cancelled)
 {
+    Q_ASSERT(options.method != NetworkInfo::ClusteringMethod::Unknown);
+    Q_ASSERT(options.batchSize > 0);
+    Q_ASSERT(options.restarts > 0);
+
     // Initialize here allowing to call this function repeatedly
     m_clusters.clear();
-    m_sampleClusterMap.clear();
-    if (m_samples.isEmpty())
-        return;
+    m_centers.clear();
+    m_assignments.clear();
+    m_averageDistances.clear();
+    m_inertia = qInf();
+    if (m_sampleCount == 0 || m_columns == 0 || clusterCount <= 0)
+        return true;
+    m_options = options;
+    m_cancelled = cancelled;
 
-    std::uniform_int_distribution<int> dist(0, m_samples.size() - 1);
-    QSet<int> used;
     //
-    // Randomly choose cluster centers according to the sample space
+    // Seed every run from the generator of this object, so that the runs are
+    // independent of the thread they end up in
     //
-    for (int i = 0; i < clusterCount; i++) {
-        // Pick a random initial sample, make sure to select different ones
-        // if there is enough of them available
-        int index;
-        do {
-            index = dist(m_generator);
-        } while (used.contains(index) && used.size() < m_samples.size());
-        used << index;
-        m_clusters.append(m_samples.at(index).inputs());
+    QVector<std::mt19937::result_type> seeds;
+    for (int i = 0; i < m_options.restarts; i++)
+        seeds.append(m_generator());
+
+    QVector<QFuture<Run>> futures;
+    for (int i = 1; i < m_options.restarts; i++) {
+        auto seed = seeds.at(i);
+        futures.append(QtConcurrent::run([this, clusterCount, seed] {
+            return cluster(clusterCount, seed, nullptr);
+        }));
+    }
+    Run best = cluster(clusterCount, seeds.at(0), [this](int iteration, int changed, double inertia) {
+        emit progress(iteration, changed, inertia);
+    });
+    for (auto& future : futures) {
+        Run run = future.result();
+        if (run.cancelled || run.inertia < best.inertia)
+            best = std::move(run);
+    }
+    m_cancelled = nullptr;
+    if (best.cancelled) {
+        qDebug() << "K-Means cancelled";
+        return false;
+    }
+    qDebug() << "K-Means finished in" << best.iterations << "iterations with inertia" << best.inertia;
+
+    m_centers = std::move(best.centers);
+    m_assignments = std::move(best.assignments);
+    m_inertia = best.inertia;
+
+    updateClusters();
+    updateAverageDistances();
+    return true;
+}
+
+//
+// Perform a single run of the algorithm, this may run in any thread
+//
+KMeansClustering::Run KMeansClustering::cluster(int clusterCount, std::mt19937::result_type seed,
+                                                const ProgressFunction& reportProgress) const
+{
+    if (m_options.method == NetworkInfo::ClusteringMethod::MiniBatch)
+        return clusterMiniBatch(clusterCount, seed, reportProgress);
+
+    std::mt19937 generator(seed);
+    QElapsedTimer timer;
+    timer.start();
+
+    Run run;
+    seedCenters(run, clusterCount, QVector<int>(), generator);
+    if (isCancelled()) {
+        run.cancelled = true;
+        return run;
     }
+
     // Find the closest cluster for each sample
-    for (int i = 0; i < m_samples.size(); i++)
-        m_sampleClusterMap[i] = findClosestCluster(m_samples.at(i));
+    assignSamples(run);
 
     //
     // Repeatedly:
@@ -77,40 +150,414 @@ void KMeansClustering::doClustering(int clusterCount)
     //  change every sample's cluster to the cluster which is closest to it
     //  repeat until no changes happen
     //
-    int iteration = 1;
+    run.iterations = 1;
+    QVector<double> previousCenters;
     while (true) {
-        recalculateClusters();
+        previousCenters = run.centers;
+        recalculateClusters(run);
+        int changed = reassignSamples(run, previousCenters);
+        if (changed == 0)
+            break;
+        if (isCancelled()) {
+            run.cancelled = true;
+            return run;
+        }
+        if (reportProgress && timer.elapsed() >= ProgressInterval) {
+            updateInertia(run);
+            reportProgress(run.iterations, changed, run.inertia);
+            timer.restart();
+        }
+        run.iterations++;
+    }
+
+    updateInertia(run);
+    return run;
+}
+
+//
+// Perform a single run of the mini-batch algorithm, this may run in any thread.
+//
+// Every iteration assigns a random batch of samples to the closest clusters and
+// moves each cluster towards its samples with the learning rate given by the
+// inverse of the number of samples the cluster has received so far. The run stops
+// when no cluster moves farther than the tolerance times the standard deviation
+// of the samples, or when the relative change of the average batch inertia
+// smoothed over the iterations falls below the epsilon.
+//
+// The reported progress counts the batch samples which have changed their cluster
+// since they were last drawn, and the inertia is estimated from the smoothed
+// batch inertia.
+//
+// D. Sculley, Web-scale k-means clustering, WWW 2010
+//
+KMeansClustering::Run KMeansClustering::clusterMiniBatch(int clusterCount, std::mt19937::result_type seed,
+                                                         const ProgressFunction& reportProgress) const
+{
+    std::mt19937 generator(seed);
+    QElapsedTimer timer;
+    timer.start();
+    std::uniform_int_distribution<int> sampleDist(0, m_sampleCount - 1);
+    const int batchSize = qMin(m_options.batchSize, m_sampleCount);
+
+    Run run;
+    //
+    // Seed the centers from a random part of the samples, which is enough for
+    // the initial centers and keeps the seeding cheap
+    //
+    QVector<int> candidates;
+    const int candidateCount = qMax(clusterCount, MiniBatchSeedingFactor * batchSize);
+    if (candidateCount < m_sampleCount) {
+        candidates.resize(m_sampleCount);
+        for (int i = 0; i < m_sampleCount; i++)
+            candidates[i] = i;
+        for (int i = 0; i < candidateCount; i++) {
+            std::uniform_int_distribution<int> dist(i, m_sampleCount - 1);
+            std::swap(candidates[i], candidates[dist(generator)]);
+        }
+        candidates.resize(candidateCount);
+    }
+    seedCenters(run, clusterCount, candidates, generator);
+    if (isCancelled()) {
+        run.cancelled = true;
+        return run;
+    }
+    run.assignments.fill(-1, m_sampleCount);
+
+    //
+    // The tolerance is relative to the spread of the samples
+    //
+    const double tolerance = m_options.tolerance * std::sqrt(sampleVariance());
+    const double toleranceSquared = tolerance * tolerance;
+    const double smoothing = qMin(1.0, 2.0 * batchSize / (m_sampleCount + 1));
+
+    QVector<int> counts(clusterCount, 0);
+    QVector<int> batch(batchSize);
+    QVector<int> batchAssignments(batchSize);
+    QVector<double> previousCenters;
+    double smoothedInertia = 0.0;
+    for (run.iterations = 1; run.iterations < MiniBatchMaxIterations; run.iterations++) {
+        double batchInertia = 0.0;
         int changed = 0;
-        for (int i = 0; i < m_samples.size(); i++) {
-            int clusterIndex = findClosestCluster(m_samples.at(i));
-            if (clusterIndex != m_sampleClusterMap[i]) {
+        for (int b = 0; b < batchSize; b++) {
+            double distance;
+            int sampleIndex = sampleDist(generator);
+            int clusterIndex = findClosestCluster(run.centers, sampleInputs(sampleIndex), &distance);
+            int& assignment = run.assignments[sampleIndex];
+            if (assignment >= 0 && assignment != clusterIndex)
                 changed++;
-                m_sampleClusterMap[i] = clusterIndex;
-            }
+            assignment = clusterIndex;
+            batch[b] = sampleIndex;
+            batchAssignments[b] = clusterIndex;
+            batchInertia += distance;
         }
-        qDebug() << "K-Means iteration" << iteration << "changed assignments:" << changed;
-        if (changed == 0)
+        batchInertia /= batchSize;
+
+        previousCenters = run.centers;
+        for (int b = 0; b < batchSize; b++) {
+            int clusterIndex = batchAssignments.at(b);
+            double rate = 1.0 / ++counts[clusterIndex];
+            double* center = run.centers.data() + clusterIndex * m_columns;
+            const double* input = sampleInputs(batch.at(b));
+            for (int column = 0; column < m_columns; column++)
+                center[column] += rate * (input[column] - center[column]);
+        }
+        double maxShift = 0.0;
+        for (int j = 0; j < clusterCount; j++) {
+            maxShift = qMax(maxShift, VectorKernels::squaredDistance(previousCenters.constData() + j * m_columns,
+                                                                     run.centers.constData() + j * m_columns,
+                                                                     m_columns));
+        }
+        if (maxShift <= toleranceSquared)
+            break;
+
+        double previousInertia = smoothedInertia;
+        if (run.iterations == 1)
+            smoothedInertia = batchInertia;
+        else
+            smoothedInertia = smoothedInertia * (1 - smoothing) + batchInertia * smoothing;
+        if (run.iterations > 1 && std::abs(smoothedInertia - previousInertia) <= m_options.epsilon * previousInertia)
             break;
-        iteration++;
-        QApplication::processEvents();
+
+        if (isCancelled()) {
+            run.cancelled = true;
+            return run;
+        }
+        if (reportProgress && timer.elapsed() >= ProgressInterval) {
+            reportProgress(run.iterations, changed, smoothedInertia * m_sampleCount);
+            timer.restart();
+        }
     }
-    qDebug() << "K-Means finished in" << iteration << "iterations";
+
+    // Find the closest cluster for each sample
+    assignSamples(run);
+    updateInertia(run);
+    return run;
 }
 
-double KMeansClustering::averageClusterDistance(int clusterIndex) const
+//
+// Return the average variance of the sample inputs
+//
+double KMeansClustering::sampleVariance() const
 {
-    const KCluster& cluster = m_clusters.at(clusterIndex);
-    int count = 0;
-    double totalDistance = 0.0;
-    for (int i = 0; i < m_samples.size(); i++) {
-        if (m_sampleClusterMap[i] != clusterIndex) {
-            // Sample belongs to a different cluster
-            continue;
+    QVector<double> mean(m_columns, 0.0);
+    for (int i = 0; i < m_sampleCount; i++)
+        VectorKernels::axpy(1.0, sampleInputs(i), mean.data(), m_columns);
+    for (auto& value : mean)
+        value /= m_sampleCount;
+
+    double variance = 0.0;
+    for (int i = 0; i < m_sampleCount; i++)
+        variance += VectorKernels::squaredDistance(sampleInputs(i), mean.constData(), m_columns);
+
+    return variance / (static_cast<double>(m_sampleCount) * m_columns);
+}
+
+//
+// Compute the sum of the squared distances of the samples to their clusters
+//
+void KMeansClustering::updateInertia(Run& run) const
+{
+    run.inertia = 0.0;
+    for (int i = 0; i < m_sampleCount; i++) {
+        const double* center = run.centers.constData() + run.assignments.at(i) * m_columns;
+        run.inertia += VectorKernels::squaredDistance(center, sampleInputs(i), m_columns);
+    }
+}
+
+//
+// Choose the initial cluster centers using the k-means++ seeding: the first
+// center is a random sample and every further center is a sample chosen with
+// the probability proportional to its squared distance to the closest center
+// chosen so far.
+//
+// The centers are chosen from the given samples, or from all samples if the
+// list is empty.
+//
+void KMeansClustering::seedCenters(Run& run, int clusterCount, const QVector<int>& candidates,
+                                   std::mt19937& generator) const
+{
+    const int count = candidates.isEmpty() ? m_sampleCount : candidates.size();
+    auto candidateInputs = [this, &candidates](int i) {
+        return sampleInputs(candidates.isEmpty() ? i : candidates.at(i));
+    };
+    run.centers.resize(clusterCount * m_columns);
+
+    std::uniform_int_distribution<int> uniformDist(0, count - 1);
+    int index = uniformDist(generator);
+    std::memcpy(run.centers.data(), candidateInputs(index), m_columns * sizeof(double));
+
+    QVector<double> distances(count);
+    double total = 0.0;
+    for (int i = 0; i < count; i++) {
+        distances[i] = VectorKernels::squaredDistance(run.centers.constData(), candidateInputs(i), m_columns);
+        total += distances.at(i);
+    }
+    for (int k = 1; k < clusterCount; k++) {
+        // The caller checks the cancellation as well and drops the run
+        if (isCancelled())
+            return;
+        //
+        // Fewer distinct samples than clusters, the remaining centers are random
+        //
+        if (total <= 0.0) {
+            index = uniformDist(generator);
+        } else {
+            std::uniform_real_distribution<double> realDist(0.0, total);
+            double target = realDist(generator);
+            //
+            // The rounding of the total may leave the target unreached, take
+            // the last sample which may be chosen then
+            //
+            index = -1;
+            for (int i = 0; i < count; i++) {
+                if (distances.at(i) <= 0.0)
+                    continue;
+                index = i;
+                target -= distances.at(i);
+                if (target < 0.0)
+                    break;
+            }
+        }
+        double* center = run.centers.data() + k * m_columns;
+        std::memcpy(center, candidateInputs(index), m_columns * sizeof(double));
+
+        total = 0.0;
+        for (int i = 0; i < count; i++) {
+            double distance = VectorKernels::squaredDistance(center, candidateInputs(i), m_columns);
+            if (distance < distances.at(i))
+                distances[i] = distance;
+            total += distances.at(i);
+        }
+    }
+}
+
+//
+// Assign every sample to its closest cluster and initialize the distance bounds
+//
+void KMeansClustering::assignSamples(Run& run) const
+{
+    const bool bounded = (m_options.algorithm == Algorithm::Hamerly);
+
+    run.assignments.resize(m_sampleCount);
+    if (bounded) {
+        run.upperBounds.resize(m_sampleCount);
+        run.lowerBounds.resize(m_sampleCount);
+    }
+    //
+    // The chunks write to the vectors through pointers, which never detach
+    //
+    int* assignments = run.assignments.data();
+    double* upperBounds = run.upperBounds.data();
+    double* lowerBounds = run.lowerBounds.data();
+    forEachSampleChunk([&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            double distance;
+            double secondDistance;
+            assignments[i] = findClosestCluster(run.centers, sampleInputs(i), &distance, &secondDistance);
+            if (bounded) {
+                upperBounds[i] = std::sqrt(distance) * (1 + BoundTolerance);
+                lowerBounds[i] = std::sqrt(secondDistance) * (1 - BoundTolerance);
+            }
+        }
+        return 0;
+    });
+}
+
+//
+// Assign every sample to its closest cluster after the clusters have moved, return
+// the number of samples whose cluster has changed
+//
+int KMeansClustering::reassignSamples(Run& run, const QVector<double>& previousCenters) const
+{
+    if (m_options.algorithm == Algorithm::Hamerly)
+        return reassignSamplesHamerly(run, previousCenters);
+
+    int* assignments = run.assignments.data();
+    return forEachSampleChunk([this, &run, assignments](int begin, int end) {
+        int changed = 0;
+        for (int i = begin; i < end; i++) {
+            int clusterIndex = findClosestCluster(run.centers, sampleInputs(i));
+            if (clusterIndex != assignments[i]) {
+                changed++;
+                assignments[i] = clusterIndex;
+            }
         }
-        totalDistance += VectorUtilities::distance(cluster, m_samples.at(i).inputs());
-        count++;
+        return changed;
+    });
+}
+
+//
+// Hamerly's algorithm, the bounds are moved by the distances the clusters have
+// moved and a sample keeps its cluster without computing any distance when its
+// upper bound is below the lower bound or half the distance from its cluster to
+// the closest other cluster. Only the remaining samples are searched like in
+// Lloyd's algorithm, so the result is the same.
+//
+// Greg Hamerly, Making k-means even faster, SDM 2010
+//
+int KMeansClustering::reassignSamplesHamerly(Run& run, const QVector<double>& previousCenters) const
+{
+    const int clusterCount = run.centers.size() / m_columns;
+    const double* centers = run.centers.constData();
+
+    QVector<double> drifts(clusterCount);
+    double maxDrift = 0.0;
+    for (int j = 0; j < clusterCount; j++) {
+        drifts[j] = std::sqrt(VectorKernels::squaredDistance(previousCenters.constData() + j * m_columns,
+                                                             centers + j * m_columns,
+                                                             m_columns));
+        maxDrift = qMax(maxDrift, drifts.at(j));
     }
-    return (count > 0) ? totalDistance / count : 0;
+    //
+    // Half the distance from each cluster to the closest other cluster
+    //
+    QVector<double> halfDistances(clusterCount, qInf());
+    for (int j = 0; j < clusterCount; j++) {
+        for (int k = j + 1; k < clusterCount; k++) {
+            double distance = std::sqrt(VectorKernels::squaredDistance(centers + j * m_columns,
+                                                                       centers + k * m_columns,
+                                                                       m_columns));
+            halfDistances[j] = qMin(halfDistances.at(j), distance);
+            halfDistances[k] = qMin(halfDistances.at(k), distance);
+        }
+    }
+    for (auto& halfDistance : halfDistances)
+        halfDistance *= 0.5 * (1 - BoundTolerance);
+
+    int* assignments = run.assignments.data();
+    double* upperBounds = run.upperBounds.data();
+    double* lowerBounds = run.lowerBounds.data();
+    return forEachSampleChunk([&](int begin, int end) {
+        int changed = 0;
+        for (int i = begin; i < end; i++) {
+            const int clusterIndex = assignments[i];
+            double& upper = upperBounds[i];
+            double& lower = lowerBounds[i];
+
+            upper = (upper + drifts.at(clusterIndex)) * (1 + BoundTolerance);
+            lower = lower - maxDrift - BoundTolerance * (lower + maxDrift);
+
+            double bound = qMax(halfDistances.at(clusterIndex), lower);
+            if (upper < bound)
+                continue;
+            //
+            // Tighten the upper bound to the exact distance and try again
+            //
+            const double* input = sampleInputs(i);
+            upper = std::sqrt(VectorKernels::squaredDistance(centers + clusterIndex * m_columns,
+                                                             input, m_columns)) * (1 + BoundTolerance);
+            if (upper < bound)
+                continue;
+
+            double distance;
+            double secondDistance;
+            int closest = findClosestCluster(run.centers, input, &distance, &secondDistance);
+            upper = std::sqrt(distance) * (1 + BoundTolerance);
+            lower = std::sqrt(secondDistance) * (1 - BoundTolerance);
+            if (closest != clusterIndex) {
+                changed++;
+                assignments[i] = closest;
+            }
+        }
+        return changed;
+    });
+}
+
+bool KMeansClustering::isCancelled() const
+{
+    return m_cancelled && m_cancelled();
+}
+
+//
+// Call the function for consecutive ranges [begin, end) of the samples and return
+// the sum of the results. The ranges are processed in parallel, this thread takes
+// the first one while waiting for the others.
+//
+// The threads are shared with the parallel runs of the algorithm.
+//
+int KMeansClustering::forEachSampleChunk(const std::function<int(int, int)>& function) const
+{
+    int threads = qBound(1, m_sampleCount / AssignmentChunkSize,
+                         qMax(1, QThread::idealThreadCount() / m_options.restarts));
+    int chunk = (m_sampleCount + threads - 1) / threads;
+
+    QVector<QFuture<int>> futures;
+    for (int begin = chunk; begin < m_sampleCount; begin += chunk) {
+        int end = qMin(begin + chunk, m_sampleCount);
+        futures.append(QtConcurrent::run([&function, begin, end] {
+            return function(begin, end);
+        }));
+    }
+    int result = function(0, qMin(chunk, m_sampleCount));
+    for (auto& future : futures)
+        result += future.result();
+
+    return result;
+}
+
+double KMeansClustering::averageClusterDistance(int clusterIndex) const
+{
+    return m_averageDistances.at(clusterIndex);
 }
 
 const KMeansClustering::KClusterVector& KMeansClustering::clusters() const
@@ -118,61 +565,137 @@ const KMeansClustering::KClusterVector& KMeansClustering::clusters() const
     return m_clusters;
 }
 
+//
+// Return the sum of the squared distances of the samples to their cluster centers
+//
+double KMeansClustering::inertia() const
+{
+    return m_inertia;
+}
+
 int KMeansClustering::sampleClusterIndex(int sampleIndex) const
 {
-    if (m_sampleClusterMap.contains(sampleIndex))
-        return m_sampleClusterMap[sampleIndex];
+    if (sampleIndex >= 0 && sampleIndex < m_assignments.size())
+        return m_assignments.at(sampleIndex);
 
     return -1;
 }
 
-int KMeansClustering::findClosestCluster(const TrainingSample& sample)
+const double* KMeansClustering::sampleInputs(int sampleIndex) const
+{
+    return m_inputs.constData() + sampleIndex * m_columns;
+}
+
+//
+// Return the index of the cluster closest to the input, of the equally close clusters
+// the one with the lowest index is returned.
+//
+// Optionally the squared distance to the closest cluster and the smallest squared
+// distance to the other clusters are returned as well.
+//
+int KMeansClustering::findClosestCluster(const QVector<double>& centers, const double* input,
+                                         double* distance, double* secondDistance) const
 {
+    const int clusterCount = centers.size() / m_columns;
+
     double minDistance = qInf();
+    double secondMinDistance = qInf();
     int minIndex = -1;
-    for (int i = 0; i < m_clusters.size(); i++) {
-        double distance = VectorUtilities::distance(m_clusters.at(i), sample.inputs());
-        if (distance < minDistance) {
-            minDistance = distance;
+    for (int i = 0; i < clusterCount; i++) {
+        double clusterDistance = VectorKernels::squaredDistance(centers.constData() + i * m_columns,
+                                                                input, m_columns);
+        if (clusterDistance < minDistance) {
+            secondMinDistance = minDistance;
+            minDistance = clusterDistance;
             minIndex = i;
+        } else if (clusterDistance < secondMinDistance) {
+            secondMinDistance = clusterDistance;
         }
     }
+    if (distance != nullptr)
+        *distance = minDistance;
+    if (secondDistance != nullptr)
+        *secondDistance = secondMinDistance;
+
     return minIndex;
 }
 
 double KMeansClustering::findClosestClusterDistance(int clusterIndex) const
 {
     double minDistance = qInf();
-    const auto& cluster = m_clusters.at(clusterIndex);
+    const double* cluster = m_centers.constData() + clusterIndex * m_columns;
     for (int i = 0; i < m_clusters.size(); i++) {
         if (i == clusterIndex)
             continue;
-        double distance = VectorUtilities::distance(m_clusters.at(i), cluster);
+        double distance = VectorKernels::squaredDistance(m_centers.constData() + i * m_columns,
+                                                         cluster, m_columns);
         if (distance < minDistance)
             minDistance = distance;
     }
-    return minDistance;
+    return std::sqrt(minDistance);
 }
 
-KMeansClustering::KCluster KMeansClustering::computeAverageSum(int index)
+//
+// Move every cluster center to the average of its samples, the sums of all
+// clusters are accumulated in a single pass over the samples.
+//
+// A cluster which lost all its samples keeps its center.
+//
+void KMeansClustering::recalculateClusters(Run& run) const
 {
-    int count = 0;
-    KCluster sum(m_clusters.at(0).size(), 0.0);
-    for (int i = 0; i < m_samples.size(); i++) {
-        if (m_sampleClusterMap[i] != index) {
-            // Sample belongs to a different cluster
+    const int clusterCount = run.centers.size() / m_columns;
+
+    QVector<double> sums(run.centers.size(), 0.0);
+    QVector<int> counts(clusterCount, 0);
+    for (int i = 0; i < m_sampleCount; i++) {
+        int clusterIndex = run.assignments.at(i);
+        VectorKernels::axpy(1.0, sampleInputs(i), sums.data() + clusterIndex * m_columns, m_columns);
+        counts[clusterIndex]++;
+    }
+    for (int i = 0; i < clusterCount; i++) {
+        if (counts.at(i) == 0)
             continue;
-        }
-        VectorUtilities::addEach(sum, m_samples.at(i).inputs());
-        count++;
+
+        double* center = run.centers.data() + i * m_columns;
+        const double* sum = sums.constData() + i * m_columns;
+        for (int j = 0; j < m_columns; j++)
+            center[j] = sum[j] / counts.at(i);
     }
-    if (count > 0)
-        VectorUtilities::divideEach(sum, count);
-    return sum;
 }
 
-void KMeansClustering::recalculateClusters()
+//
+// Compute the average distance of the samples of every cluster to its center
+//
+void KMeansClustering::updateAverageDistances()
 {
-    for (int i = 0; i < m_clusters.size(); i++)
-        m_clusters[i] = computeAverageSum(i);
+    const int clusterCount = m_clusters.size();
+
+    QVector<int> counts(clusterCount, 0);
+    m_averageDistances.fill(0.0, clusterCount);
+    for (int i = 0; i < m_sampleCount; i++) {
+        int clusterIndex = m_assignments.at(i);
+        m_averageDistances[clusterIndex] +=
+                std::sqrt(VectorKernels::squaredDistance(m_centers.constData() + clusterIndex * m_columns,
+                                                         sampleInputs(i), m_columns));
+        counts[clusterIndex]++;
+    }
+    for (int i = 0; i < clusterCount; i++) {
+        if (counts.at(i) > 0)
+            m_averageDistances[i] /= counts.at(i);
+    }
+}
+
+//
+// Copy the cluster centers to the vectors returned by clusters()
+//
+void KMeansClustering::updateClusters()
+{
+    const int clusterCount = m_centers.size() / m_columns;
+
+    m_clusters.resize(clusterCount);
+    for (int i = 0; i < clusterCount; i++) {
+        const double* center = m_centers.constData() + i * m_columns;
+        m_clusters[i].resize(m_columns);
+        std::memcpy(m_clusters[i].data(), center, m_columns * sizeof(double));
+    }
 }
@@ -21,9 +21,11 @@
 
 #include "common.h"
 
+#include <functional>
 #include <random>
 #include <QObject>
 
+#include "networkinfo.h"
 #include "trainingsample.h"
 
 class KMeansClustering : public QObject
@@ -33,24 +35,132 @@ public:
     using KCluster = QVector<double>;
     using KClusterVector = QVector<KCluster>;
 
+    //
+    // Default options of the mini-batch method
+    //
+    static constexpr int DefaultBatchSize = 1024;
+    static constexpr double DefaultTolerance = 1e-3;
+    static constexpr double DefaultEpsilon = 1e-4;
+
+    //
+    // Algorithm assigning the samples to the clusters in every iteration, both
+    // give the same results
+    //
+    enum class Algorithm {
+        Lloyd,      // Compute the distances to all clusters
+        Hamerly     // Skip the samples whose cluster cannot change using distance bounds
+    };
+
+    //
+    // Options of the clustering, they are passed to doClustering() so that they
+    // cannot change while the clustering runs
+    //
+    struct Options {
+        NetworkInfo::ClusteringMethod method = NetworkInfo::ClusteringMethod::Full;
+        // Number of samples in every iteration of the mini-batch method
+        int batchSize = DefaultBatchSize;
+        // Largest movement of the clusters, relative to the standard deviation of
+        // the samples, which stops the mini-batch method
+        double tolerance = DefaultTolerance;
+        // Relative change of the smoothed batch inertia which stops the mini-batch
+        // method
+        double epsilon = DefaultEpsilon;
+        Algorithm algorithm = Algorithm::Hamerly;
+        // Number of runs of the algorithm from different initial centers
+        int restarts = 1;
+    };
+
     explicit KMeansClustering(QObject* parent = nullptr);
     explicit KMeansClustering(const QVector<TrainingSample>& samples, QObject* parent = nullptr);
 
     void setTrainingSamples(const QVector<TrainingSample>& samples);
-    void doClustering(int clusterCount);
+    bool doClustering(int clusterCount, const Options& options,
+                      const std::function<bool()>& cancelled = nullptr);
 
     double averageClusterDistance(int clusterIndex) const;
     double findClosestClusterDistance(int clusterIndex) const;
     const KClusterVector& clusters() const;
+    double inertia() const;
     int sampleClusterIndex(int sampleIndex) const;
 
+signals:
+    void progress(int iteration, int changed, double inertia);
+
 private:
-    KCluster computeAverageSum(int index);
-    int findClosestCluster(const TrainingSample& sample);
-    void recalculateClusters();
+    //
+    // State of a single run of the algorithm, the runs are independent of each
+    // other and may be performed in parallel
+    //
+    struct Run {
+        QVector<double> centers;
+        QVector<int> assignments;
+        double inertia = qInf();
+        int iterations = 0;
+        bool cancelled = false;
+        //
+        // Upper bounds of the distances of the samples to their clusters and lower
+        // bounds of the distances to all other clusters, used by Hamerly's algorithm
+        //
+        QVector<double> upperBounds;
+        QVector<double> lowerBounds;
+    };
+    using ProgressFunction = std::function<void(int, int, double)>;
+
+    //
+    // Relative slack added to the distance bounds to cover the rounding errors,
+    // the bounds then never skip a sample whose cluster could change
+    //
+    static constexpr double BoundTolerance = 1e-12;
+    //
+    // The mini-batch method seeds the clusters from this many batches of samples
+    // and stops after the given number of iterations at the latest
+    //
+    static constexpr int MiniBatchSeedingFactor = 3;
+    static constexpr int MiniBatchMaxIterations = 1000;
+    //
+    // The samples are assigned to the clusters in parallel in chunks of at least
+    // this many samples, and the progress is reported at most once per interval
+    // in milliseconds
+    //
+    static constexpr int AssignmentChunkSize = 2048;
+    static constexpr int ProgressInterval = 250;
+
+    Run cluster(int clusterCount, std::mt19937::result_type seed,
+                const ProgressFunction& reportProgress) const;
+    Run clusterMiniBatch(int clusterCount, std::mt19937::result_type seed,
+                         const ProgressFunction& reportProgress) const;
+    bool isCancelled() const;
+    int forEachSampleChunk(const std::function<int(int, int)>& function) const;
+    void seedCenters(Run& run, int clusterCount, const QVector<int>& candidates,
+                     std::mt19937& generator) const;
+    void assignSamples(Run& run) const;
+    int reassignSamples(Run& run, const QVector<double>& previousCenters) const;
+    int reassignSamplesHamerly(Run& run, const QVector<double>& previousCenters) const;
+    const double* sampleInputs(int sampleIndex) const;
+    int findClosestCluster(const QVector<double>& centers, const double* input,
+                           double* distance = nullptr, double* secondDistance = nullptr) const;
+    void recalculateClusters(Run& run) const;
+    double sampleVariance() const;
+    void updateInertia(Run& run) const;
+    void updateAverageDistances();
+    void updateClusters();
 
     std::mt19937 m_generator;
-    QVector<TrainingSample> m_samples;
+    Options m_options;
+    double m_inertia = qInf();
+    std::function<bool()> m_cancelled;
+    //
+    // Inputs of the samples and the cluster centers stored as the rows of flat
+    // row-major arrays with m_columns columns
+    //
+    QVector<double> m_inputs;
+    QVector<double> m_centers;
+    int m_columns = 0;
+    int m_sampleCount = 0;
+    //
+    // Index of the cluster of every sample
+    //
+    QVector<int> m_assignments;
+    QVector<double> m_averageDistances;
     QVector<KCluster> m_clusters;
-    QMap<int, int> m_sampleClusterMap;
 };
@@ -0,0 +1,70 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "kohonenconnectionsitem.h"
+
+#include <QPolygonF>
+
+#include "colors.h"
+
+KohonenConnectionsItem::KohonenConnectionsItem(QGraphicsItem* parent) :
+    QGraphicsItem(parent)
+{
+    //
+    // Keep the connections below the neurons
+    //
+    setZValue(-1);
+}
+
+QRectF KohonenConnectionsItem::boundingRect() const
+{
+    return m_boundingRect;
+}
+
+//
+// Set the centers of the input neurons and the rectangle of the map
+//
+void KohonenConnectionsItem::setGeometry(const QVector<QPointF>& inputs, const QRectF& mapRect)
+{
+    QRectF rect = mapRect;
+    for (const auto& point : inputs)
+        rect |= QRectF(point, QSizeF(1, 1));
+
+    prepareGeometryChange();
+    m_inputs = inputs;
+    m_mapRect = mapRect;
+    m_boundingRect = rect;
+}
+
+void KohonenConnectionsItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (m_mapRect.isEmpty())
+        return;
+
+    painter->setPen(QPen(Colors::ColorKohonenConnections, 0));
+    painter->setBrush(Colors::ColorKohonenConnectionsFill);
+    for (const auto& point : qAsConst(m_inputs)) {
+        QPolygonF fan;
+        fan << point << m_mapRect.topLeft() << m_mapRect.bottomLeft();
+        painter->drawPolygon(fan);
+    }
+}
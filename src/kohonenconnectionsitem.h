@@ -0,0 +1,48 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+//
+// Connections between the input layer and a large Kohonen map drawn as a single
+// item, every input neuron is joined to the whole left edge of the map
+//
+class KohonenConnectionsItem : public QGraphicsItem
+{
+public:
+    explicit KohonenConnectionsItem(QGraphicsItem* parent = nullptr);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+    void setGeometry(const QVector<QPointF>& inputs, const QRectF& mapRect);
+
+private:
+    QVector<QPointF> m_inputs;
+    QRectF m_mapRect;
+    QRectF m_boundingRect;
+};
@@ -0,0 +1,171 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "kohonenmapitem.h"
+
+#include <QStyleOptionGraphicsItem>
+
+#include "colors.h"
+#include "kohonenoutputlayer.h"
+
+KohonenMapItem::KohonenMapItem(const KohonenOutputLayer* layer, QGraphicsItem* parent) :
+    QGraphicsItem(parent),
+    m_layer(layer)
+{
+    //
+    // The exposed rectangle limits the details drawn when zoomed in
+    //
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+QRectF KohonenMapItem::boundingRect() const
+{
+    return m_rect;
+}
+
+void KohonenMapItem::setRect(const QRectF& rect)
+{
+    if (m_rect != rect) {
+        prepareGeometryChange();
+        m_rect = rect;
+    }
+}
+
+//
+// Redraw the image after the values or weights of the neurons have changed
+//
+void KohonenMapItem::invalidate()
+{
+    m_imageValid = false;
+    update();
+}
+
+void KohonenMapItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+
+    if (m_rect.isEmpty())
+        return;
+    if (!m_imageValid)
+        updateImage();
+    if (m_image.isNull())
+        return;
+
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter->drawImage(m_rect, m_image);
+    painter->restore();
+
+    const double lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const double cellSize = qMin(m_rect.width() / m_image.width(),
+                                 m_rect.height() / m_image.height());
+    if (cellSize * lod >= DetailCellSize)
+        paintDetails(painter, option->exposedRect & m_rect);
+}
+
+//
+// Draw the cell outlines and mark the BMU in the exposed part of the map
+//
+void KohonenMapItem::paintDetails(QPainter* painter, const QRectF& exposedRect)
+{
+    if (exposedRect.isEmpty())
+        return;
+
+    const int gridWidth = m_image.width();
+    const int gridHeight = m_image.height();
+    const double cellWidth = m_rect.width() / gridWidth;
+    const double cellHeight = m_rect.height() / gridHeight;
+
+    const int x0 = qBound(0, static_cast<int>((exposedRect.left() - m_rect.left()) / cellWidth), gridWidth - 1);
+    const int x1 = qBound(0, static_cast<int>((exposedRect.right() - m_rect.left()) / cellWidth), gridWidth - 1);
+    const int y0 = qBound(0, static_cast<int>((exposedRect.top() - m_rect.top()) / cellHeight), gridHeight - 1);
+    const int y1 = qBound(0, static_cast<int>((exposedRect.bottom() - m_rect.top()) / cellHeight), gridHeight - 1);
+
+    painter->save();
+    painter->setPen(QPen(Colors::ColorText, 0));
+    painter->setBrush(Qt::NoBrush);
+    for (int x = x0; x <= x1 + 1; x++) {
+        double left = m_rect.left() + x * cellWidth;
+        painter->drawLine(QPointF(left, m_rect.top() + y0 * cellHeight),
+                          QPointF(left, m_rect.top() + (y1 + 1) * cellHeight));
+    }
+    for (int y = y0; y <= y1 + 1; y++) {
+        double top = m_rect.top() + y * cellHeight;
+        painter->drawLine(QPointF(m_rect.left() + x0 * cellWidth, top),
+                          QPointF(m_rect.left() + (x1 + 1) * cellWidth, top));
+    }
+
+    if (m_layer->neuronCount() > 0 && m_layer->neuron(0)->showValue()) {
+        //
+        // Draw the number "1" with a bold font into the BMU cell
+        //
+        auto font = painter->font();
+        font.setBold(true);
+        font.setPixelSize(qMax(1.0, qMin(cellWidth, cellHeight) * 0.35));
+        painter->setFont(font);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                int index = m_layer->gridNeuron(x, y);
+                if (index < 0 || !qFuzzyCompare(m_layer->neuron(index)->value(), 1.0))
+                    continue;
+
+                QRectF cell(m_rect.left() + x * cellWidth, m_rect.top() + y * cellHeight,
+                            cellWidth, cellHeight);
+                painter->drawText(cell, QStringLiteral("1"), Qt::AlignHCenter | Qt::AlignVCenter);
+            }
+        }
+    }
+    painter->restore();
+}
+
+void KohonenMapItem::updateImage()
+{
+    const QSize gridSize = m_layer->gridSize();
+    if (gridSize.isEmpty()) {
+        m_image = QImage();
+        m_imageValid = true;
+        return;
+    }
+    if (m_image.size() != gridSize)
+        m_image = QImage(gridSize, QImage::Format_RGB32);
+
+    const bool showValues = m_layer->neuronCount() > 0 && m_layer->neuron(0)->showValue();
+
+    QVector<double> distances;
+    if (!showValues)
+        distances = m_layer->neighborDistances();
+
+    for (int y = 0; y < gridSize.height(); y++) {
+        auto* line = reinterpret_cast<QRgb*>(m_image.scanLine(y));
+        for (int x = 0; x < gridSize.width(); x++) {
+            int index = m_layer->gridNeuron(x, y);
+            if (index < 0) {
+                line[x] = QColor(Qt::white).rgb();
+                continue;
+            }
+            if (showValues)
+                line[x] = Colors::colorKohonenOutputNeuronValue(m_layer->neuron(index)->value()).rgb();
+            else if (!distances.isEmpty())
+                line[x] = Colors::colorKohonenMapDistance(distances.at(index)).rgb();
+            else
+                line[x] = Colors::ColorKohonenOutputInitial.rgb();
+        }
+    }
+    m_imageValid = true;
+}
@@ -0,0 +1,63 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QGraphicsItem>
+#include <QImage>
+#include <QPainter>
+#include <QRectF>
+
+class KohonenOutputLayer;
+
+//
+// Kohonen map drawn as a single image with one pixel per neuron, used for maps
+// too large to have an item for every neuron.
+//
+// Each neuron is colored by its value when neuron values are shown, otherwise by
+// the average distance of its weights to the weights of its grid neighbors. When
+// zoomed in enough, the cells get outlines and the BMU is marked like a neuron.
+//
+class KohonenMapItem : public QGraphicsItem
+{
+public:
+    explicit KohonenMapItem(const KohonenOutputLayer* layer, QGraphicsItem* parent = nullptr);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+    void setRect(const QRectF& rect);
+    void invalidate();
+
+private:
+    //
+    // Minimal size of a cell on the screen in pixels to draw its details
+    //
+    static constexpr double DetailCellSize = 16.0;
+
+    void paintDetails(QPainter* painter, const QRectF& exposedRect);
+    void updateImage();
+
+    const KohonenOutputLayer* m_layer;
+    QRectF m_rect;
+    QImage m_image;
+    bool m_imageValid = false;
+};
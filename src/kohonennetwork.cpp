@@ -19,10 +19,14 @@
  */
 #include "kohonennetwork.h"
 
+#include <QMutexLocker>
+
 #include "graphicsutilities.h"
+#include "kohonenconnectionsitem.h"
 #include "kohoneninputlayer.h"
 #include "kohonenoutputlayer.h"
 #include "kohonennetworkdefaults.h"
+#include "kohonenschedule.h"
 
 KohonenNetwork::KohonenNetwork(const NetworkInfo::Map& map, QObject* parent) :
     Network(map, parent)
@@ -42,6 +46,7 @@ KohonenNetwork::KohonenNetwork(const NetworkInfo::Map& map, QObject* parent) :
     addLayer(m_outputLayer);
 
     m_inputLayer->connectTo(m_outputLayer);
+    init();
 }
 
 KohonenNetwork::KohonenNetwork(const SavedNetwork& savedNetwork, QObject* parent) :
@@ -62,6 +67,24 @@ KohonenNetwork::KohonenNetwork(const SavedNetwork& savedNetwork, QObject* parent
     addLayer(m_outputLayer);
 
     m_inputLayer->connectTo(m_outputLayer);
+    init();
+}
+
+void KohonenNetwork::init()
+{
+    //
+    // The connections of a large map are drawn by a single item
+    //
+    if (m_outputLayer->isLargeMap()) {
+        m_connectionsItem = new KohonenConnectionsItem;
+        addToGroup(m_connectionsItem);
+    }
+}
+
+void KohonenNetwork::compute(const double* input, double* output, NetworkWorkspace& workspace) const
+{
+    Q_UNUSED(workspace);
+    m_outputLayer->computeInto(input, output);
 }
 
 void KohonenNetwork::computeAndSet(const QVector<double>& input)
@@ -83,14 +106,100 @@ void KohonenNetwork::prepareTraining()
 {
     m_localMaxEpochs = maxTrainingEpochs();
     m_localLearningRate = learningRate();
-
-    m_outputLayer->setLearningRate(m_localLearningRate);
+    m_localLearningRateSchedule = learningRateSchedule();
+    m_localNeighborhoodSchedule = neighborhoodSchedule();
+    m_localTrainingMode = trainingMode();
 }
 
 void KohonenNetwork::train(const TrainingSample& sample)
 {
+    double progress = KohonenSchedule::progress(trainingEpochs(), m_localMaxEpochs);
+    double rate = KohonenSchedule::value(m_localLearningRateSchedule,
+                                         m_localLearningRate,
+                                         progress);
+    double sigma = KohonenSchedule::value(m_localNeighborhoodSchedule,
+                                          m_outputLayer->initialSigma(),
+                                          progress);
+
     m_inputLayer->setValues(sample.inputs());
-    m_outputLayer->train(trainingEpochs(), m_localMaxEpochs);
+    if (m_localTrainingMode == NetworkInfo::KohonenTrainingMode::Batch) {
+        //
+        // Every training step is a pass over the whole training set, which does
+        // not use the learning rate, the given sample is only displayed
+        //
+        m_outputLayer->trainBatch(trainingTableModel()->store().samples(), sigma);
+        m_outputLayer->computeAndSet();
+    } else
+        m_outputLayer->train(rate, sigma);
+}
+
+//
+// The learning rate stays constant unless set otherwise
+//
+NetworkInfo::Schedule KohonenNetwork::learningRateSchedule() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::LearningRateSchedule))
+        return NetworkInfo::scheduleFromMap(m_infoMap, NetworkInfo::Key::LearningRateSchedule);
+
+    return NetworkInfo::Schedule::Constant;
+}
+
+void KohonenNetwork::setLearningRateSchedule(NetworkInfo::Schedule schedule)
+{
+    Q_ASSERT(schedule != NetworkInfo::Schedule::Unknown);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (schedule != learningRateSchedule()) {
+        m_infoMap[NetworkInfo::Key::LearningRateSchedule] = QVariant::fromValue(schedule);
+        emit infoChanged();
+    }
+}
+
+//
+// The neighborhood radius decreases linearly unless set otherwise
+//
+NetworkInfo::Schedule KohonenNetwork::neighborhoodSchedule() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::NeighborhoodSchedule))
+        return NetworkInfo::scheduleFromMap(m_infoMap, NetworkInfo::Key::NeighborhoodSchedule);
+
+    return NetworkInfo::Schedule::Linear;
+}
+
+void KohonenNetwork::setNeighborhoodSchedule(NetworkInfo::Schedule schedule)
+{
+    Q_ASSERT(schedule != NetworkInfo::Schedule::Unknown);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (schedule != neighborhoodSchedule()) {
+        m_infoMap[NetworkInfo::Key::NeighborhoodSchedule] = QVariant::fromValue(schedule);
+        emit infoChanged();
+    }
+}
+
+//
+// The weights are updated after every sample unless set otherwise
+//
+NetworkInfo::KohonenTrainingMode KohonenNetwork::trainingMode() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::KohonenTrainingMode))
+        return NetworkInfo::kohonenTrainingModeFromMap(m_infoMap);
+
+    return NetworkInfo::KohonenTrainingMode::Online;
+}
+
+void KohonenNetwork::setTrainingMode(NetworkInfo::KohonenTrainingMode mode)
+{
+    Q_ASSERT(mode != NetworkInfo::KohonenTrainingMode::Unknown);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (mode != trainingMode()) {
+        m_infoMap[NetworkInfo::Key::KohonenTrainingMode] = QVariant::fromValue(mode);
+        emit infoChanged();
+    }
 }
 
 void KohonenNetwork::updateScenePosition()
@@ -115,4 +224,13 @@ void KohonenNetwork::updateScenePosition()
 
     m_inputLayer->setX(m_outputLayer->x() - inputWidth * 2);
     m_inputLayer->setY((height - inputHeight) / 2);
+
+    if (m_connectionsItem != nullptr) {
+        QVector<QPointF> inputs;
+        for (const auto* neuron : m_inputLayer->neurons())
+            inputs.append(m_inputLayer->mapToItem(this, neuron->pos()));
+
+        m_connectionsItem->setGeometry(inputs,
+                                       m_outputLayer->mapRectToItem(this, m_outputLayer->boundingRect()));
+    }
 }
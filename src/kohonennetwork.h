@@ -21,6 +21,7 @@
 
 #include "common.h"
 
+#include "kohonenconnectionsitem.h"
 #include "kohoneninputlayer.h"
 #include "kohonenoutputlayer.h"
 #include "network.h"
@@ -33,11 +34,21 @@ public:
     explicit KohonenNetwork(const NetworkInfo::Map& map, QObject* parent = nullptr);
     explicit KohonenNetwork(const SavedNetwork& savedNetwork, QObject* parent = nullptr);
 
+    using Network::compute;
+    using Network::computeBatch;
+    void compute(const double* input, double* output, NetworkWorkspace& workspace) const override;
     void computeAndSet(const QVector<double>& input) override;
     NetworkInfo::Map createDefaultInfoMap() const override;
     void train(const TrainingSample& sample) override;
     void updateScenePosition() override;
 
+    NetworkInfo::Schedule learningRateSchedule() const;
+    void setLearningRateSchedule(NetworkInfo::Schedule schedule);
+    NetworkInfo::Schedule neighborhoodSchedule() const;
+    void setNeighborhoodSchedule(NetworkInfo::Schedule schedule);
+    NetworkInfo::KohonenTrainingMode trainingMode() const;
+    void setTrainingMode(NetworkInfo::KohonenTrainingMode mode);
+
 protected:
     void prepareTraining() override;
 
@@ -46,6 +57,10 @@ private:
 
     int m_localMaxEpochs;
     double m_localLearningRate;
+    NetworkInfo::Schedule m_localLearningRateSchedule;
+    NetworkInfo::Schedule m_localNeighborhoodSchedule;
+    NetworkInfo::KohonenTrainingMode m_localTrainingMode;
     KohonenInputLayer* m_inputLayer;
     KohonenOutputLayer* m_outputLayer;
+    KohonenConnectionsItem* m_connectionsItem = nullptr;
 };
@@ -31,11 +31,16 @@ public:
     // Neuron count limits
     //
     static constexpr int minInputNeurons = 2;
-    static constexpr int maxInputNeurons = 5;
+    static constexpr int maxInputNeurons = 32;
     static constexpr int minOutputNeuronsSide = 2;
-    static constexpr int minOutputNeurons = 4;      // 2 x 2
-    static constexpr int maxOutputNeuronsSide = 10;
-    static constexpr int maxOutputNeurons = 100;    // 10 x 10
+    static constexpr int minOutputNeurons = 4;          // 2 x 2
+    static constexpr int maxOutputNeuronsSide = 128;
+    static constexpr int maxOutputNeurons = 16384;      // 128 x 128
+
+    //
+    // Larger maps are drawn as a single image instead of one item per neuron
+    //
+    static constexpr int maxDetailedOutputNeurons = 400;    // 20 x 20
 
     //
     // Verify that the given number of neurons is correct and within the limits
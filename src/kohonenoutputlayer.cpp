@@ -20,9 +20,16 @@
 #include "kohonenoutputlayer.h"
 
 #include <cmath>
+#include <limits>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
 
 #include "graphicsutilities.h"
+#include "kohonenmapitem.h"
+#include "kohonennetworklimits.h"
 #include "kohonenoutputneuron.h"
+#include "vectorkernels.h"
 
 KohonenOutputLayer::KohonenOutputLayer(int neurons, Network *parent) :
     KohonenLayer(NetworkLayerInfo::Type::Output, parent)
@@ -54,7 +61,36 @@ void KohonenOutputLayer::init()
     // http://mathworld.wolfram.com/GaussianFunction.html
     //
     double radius = std::sqrt(neuronCount()) / 2;
-    m_sigma = radius / 1.1774;
+    m_initialSigma = radius / 1.1774;
+
+    for (int i = 0; i < neuronCount(); i++)
+        m_positions.append(kohonenOutputNeuron(i)->position());
+    //
+    // Map the grid positions to the neurons for the neighborhood lookup
+    //
+    m_gridWidth = 0;
+    m_gridHeight = 0;
+    for (const auto& position : qAsConst(m_positions)) {
+        m_gridWidth = qMax(m_gridWidth, position.x() + 1);
+        m_gridHeight = qMax(m_gridHeight, position.y() + 1);
+    }
+    m_grid.fill(-1, m_gridWidth * m_gridHeight);
+    for (int i = 0; i < m_positions.size(); i++)
+        m_grid[m_positions.at(i).y() * m_gridWidth + m_positions.at(i).x()] = i;
+
+    if (isLargeMap()) {
+        //
+        // The neurons of a large map are kept, but only the map image is shown
+        //
+        for (auto* layerNeuron : neurons())
+            layerNeuron->setVisible(false);
+
+        m_mapItem = new KohonenMapItem(this);
+        addToGroup(m_mapItem);
+        connect(this, &NetworkLayer::inWeightsChanged, this, [this] {
+            m_mapItem->invalidate();
+        });
+    }
 }
 
 void KohonenOutputLayer::computeAndSet()
@@ -62,37 +98,92 @@ void KohonenOutputLayer::computeAndSet()
     updateBMU();
 
     // Assign the value 1 to the BMU and 0 to all other output neurons
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = kohonenOutputNeuron(i);
-        if (neuron == m_bmu)
-            neuron->setValue(1);
-        else
-            neuron->setValue(0);
-    }
+    for (int i = 0; i < m_activations.size(); i++)
+        m_activations[i] = (i == m_bmuIndex) ? 1 : 0;
+
+    m_neighborhoodRows.clear();
+    if (m_bmuIndex >= 0)
+        m_neighborhoodRows.append(m_bmuIndex);
+    m_neighborhoodTracked = true;
+
+    syncNeuronValues();
 }
 
-void KohonenOutputLayer::updateBMU(double* bmuDistance)
+//
+// Compute the output values for the given input values without changing the layer,
+// the BMU gets the value 1 and all other output neurons 0
+//
+void KohonenOutputLayer::computeInto(const double* input, double* output) const
 {
-    m_bmu = nullptr;
+    int bmuIndex = findBMU(input);
 
-    double minDistance = qInf();
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = kohonenOutputNeuron(i);
+    for (int i = 0; i < m_inWeights.rows(); i++)
+        output[i] = (i == bmuIndex) ? 1 : 0;
+}
 
-        double distance = 0;
-        const auto& connections = neuron->inConnections();
-        for (auto* conn : connections) {
-            double value = conn->weight() - conn->neuron1()->value();
-            distance += value * value;
-        }
-        distance = std::sqrt(distance);
-        if (distance < minDistance) {
-            m_bmu = neuron;
+//
+// Return the index of the neuron whose weights are the closest to the input values,
+// of the equally close neurons the one with the lowest index is returned.
+//
+// The search starts with the neuron at startIndex, usually the previous BMU. As
+// the input changes little between samples, its distance is a tight bound and
+// the distances to most other neurons are abandoned after a part of the inputs,
+// the bound is checked every 8 inputs. The result is the same as that of the
+// exhaustive search.
+//
+int KohonenOutputLayer::findBMU(const double* input, double* squaredDistance, int startIndex) const
+{
+    const int rows = m_inWeights.rows();
+    const int columns = m_inWeights.columns();
+    if (rows == 0) {
+        if (squaredDistance != nullptr)
+            *squaredDistance = qInf();
+        return -1;
+    }
+    if (startIndex < 0 || startIndex >= rows)
+        startIndex = 0;
+    //
+    // The partial sums checked against the bound are rounded differently from the
+    // full distance, allow for the rounding error when abandoning a neuron
+    //
+    const double margin = 1.0 + 4 * columns * std::numeric_limits<double>::epsilon();
+    //
+    // Compare squared distances, the square root is only needed for the result
+    //
+    int bmuIndex = startIndex;
+    double minDistance = VectorKernels::squaredDistance(m_inWeights.rowData(startIndex), input, columns);
+    for (int row = 0; row < rows; row++) {
+        if (row == startIndex)
+            continue;
+
+        const double* weights = m_inWeights.rowData(row);
+        const double bound = minDistance * margin;
+        const double distance = VectorKernels::squaredDistanceBounded(weights, input, columns, bound);
+        if (distance > bound)
+            continue;
+
+        if (distance < minDistance || (distance == minDistance && row < bmuIndex)) {
+            bmuIndex = row;
             minDistance = distance;
         }
     }
+    if (squaredDistance != nullptr)
+        *squaredDistance = minDistance;
+
+    return bmuIndex;
+}
+
+void KohonenOutputLayer::updateBMU(double* bmuDistance)
+{
+    const auto* layer = previousLayer();
+    Q_ASSERT(layer != nullptr);
+
+    double minDistance;
+    m_bmuIndex = findBMU(layer->activations().constData(), &minDistance, m_bmuIndex);
+    m_bmu = (m_bmuIndex >= 0) ? kohonenOutputNeuron(m_bmuIndex) : nullptr;
+
     if (bmuDistance != nullptr)
-        *bmuDistance = minDistance;
+        *bmuDistance = std::sqrt(minDistance);
 }
 
 KohonenOutputNeuron* KohonenOutputLayer::currentBMU() const
@@ -100,6 +191,11 @@ KohonenOutputNeuron* KohonenOutputLayer::currentBMU() const
     return m_bmu;
 }
 
+int KohonenOutputLayer::currentBMUIndex() const
+{
+    return m_bmuIndex;
+}
+
 QString KohonenOutputLayer::defaultNeuronName(int index) const
 {
     const auto& map = neuron(index)->infoMap();
@@ -114,30 +210,287 @@ KohonenOutputNeuron* KohonenOutputLayer::kohonenOutputNeuron(int index) const
     return qobject_cast<KohonenOutputNeuron*>(neuron(index));
 }
 
-void KohonenOutputLayer::setLearningRate(double learningRate)
+QSize KohonenOutputLayer::gridSize() const
 {
-    for (int i = 0; i < neuronCount(); i++)
-        kohonenOutputNeuron(i)->setLearningRate(learningRate);
+    return QSize(m_gridWidth, m_gridHeight);
+}
+
+//
+// Return the index of the neuron at the given grid position, -1 for empty positions
+//
+int KohonenOutputLayer::gridNeuron(int x, int y) const
+{
+    return m_grid.at(y * m_gridWidth + x);
+}
+
+//
+// Return true if the map is too large to show every neuron and connection
+//
+bool KohonenOutputLayer::isLargeMap() const
+{
+    return neuronCount() > KohonenNetworkLimits::maxDetailedOutputNeurons;
+}
+
+bool KohonenOutputLayer::hasInConnectionItems() const
+{
+    return !isLargeMap();
+}
+
+//
+// Return the average distance of the displayed weights of every neuron to those
+// of its grid neighbors, scaled to the range [0, 1]
+//
+QVector<double> KohonenOutputLayer::neighborDistances() const
+{
+    const auto& weights = m_displayedInWeights;
+    const int columns = weights.columns();
+
+    QVector<double> distances;
+    if (weights.rows() != m_positions.size())
+        return distances;
+
+    distances.fill(0.0, m_positions.size());
+    double maxDistance = 0.0;
+    for (int row = 0; row < m_positions.size(); row++) {
+        const QPoint& position = m_positions.at(row);
+        const QPoint neighbors[] = {
+            position + QPoint(-1, 0),
+            position + QPoint(1, 0),
+            position + QPoint(0, -1),
+            position + QPoint(0, 1)
+        };
+        double sum = 0.0;
+        int count = 0;
+        for (const auto& neighbor : neighbors) {
+            if (neighbor.x() < 0 || neighbor.x() >= m_gridWidth
+                    || neighbor.y() < 0 || neighbor.y() >= m_gridHeight)
+                continue;
+            int other = gridNeuron(neighbor.x(), neighbor.y());
+            if (other < 0)
+                continue;
+
+            sum += std::sqrt(VectorKernels::squaredDistance(weights.rowData(row),
+                                                            weights.rowData(other),
+                                                            columns));
+            count++;
+        }
+        if (count > 0)
+            distances[row] = sum / count;
+        maxDistance = qMax(maxDistance, distances.at(row));
+    }
+    if (maxDistance > 0.0) {
+        for (auto& distance : distances)
+            distance /= maxDistance;
+    }
+    return distances;
 }
 
-void KohonenOutputLayer::train(int currentTrainingEpoch, int trainingEpochs)
+void KohonenOutputLayer::setShowNeuronValues(bool enabled)
+{
+    NetworkLayer::setShowNeuronValues(enabled);
+    if (m_mapItem != nullptr)
+        m_mapItem->invalidate();
+}
+
+void KohonenOutputLayer::applyNeuronValues(const QVector<double>& values)
+{
+    NetworkLayer::applyNeuronValues(values);
+    if (m_mapItem != nullptr)
+        m_mapItem->invalidate();
+}
+
+//
+// Width of the neighborhood function at the start of the training
+//
+double KohonenOutputLayer::initialSigma() const
+{
+    return m_initialSigma;
+}
+
+//
+// Move the weights towards the input using the current learning rate and width
+// of the neighborhood function
+//
+void KohonenOutputLayer::train(double learningRate, double sigma)
 {
     updateBMU();
 
-    double sigma = m_sigma - ((m_sigma * currentTrainingEpoch) / trainingEpochs);
+    const auto* layer = previousLayer();
+    Q_ASSERT(layer != nullptr);
+
+    const double* input = layer->activations().constData();
+    const int columns = m_inWeights.columns();
+
     double twoSigmaSquare = 2 * sigma * sigma;
+    //
+    // Only the neurons within the cutoff distance from the BMU are updated, they
+    // are found in the square window of the grid around the BMU
+    //
+    double cutoff = qMax(0.0, NeighborhoodCutoff * sigma);
+    double cutoffSquared = cutoff * cutoff;
+    int radius = static_cast<int>(qMin(cutoff, static_cast<double>(qMax(m_gridWidth, m_gridHeight))));
 
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = kohonenOutputNeuron(i);
-
-        int dx = qAbs(m_bmu->position().x() - neuron->position().x());
-        int dy = qAbs(m_bmu->position().y() - neuron->position().y());
-        double dxSquared = dx * dx;
-        double dySquared = dy * dy;
-        double neighborhoodValue = std::exp(-(dxSquared + dySquared) / twoSigmaSquare);
-        neuron->setValue(neighborhoodValue);
-        neuron->updateWeights();
+    //
+    // Clear the neighborhood values of the previous sample, all values are cleared
+    // the first time as they may come from elsewhere
+    //
+    if (m_neighborhoodTracked) {
+        for (int row : qAsConst(m_neighborhoodRows))
+            m_activations[row] = 0;
+    } else {
+        m_activations.fill(0.0);
+        m_neighborhoodTracked = true;
     }
+    m_neighborhoodRows.clear();
+
+    const QPoint& bmuPosition = m_positions.at(m_bmuIndex);
+    const int x0 = qMax(0, bmuPosition.x() - radius);
+    const int x1 = qMin(m_gridWidth - 1, bmuPosition.x() + radius);
+    const int y0 = qMax(0, bmuPosition.y() - radius);
+    const int y1 = qMin(m_gridHeight - 1, bmuPosition.y() + radius);
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int row = m_grid.at(y * m_gridWidth + x);
+            if (row < 0)
+                continue;
+
+            int dx = bmuPosition.x() - x;
+            int dy = bmuPosition.y() - y;
+            double distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared > cutoffSquared)
+                continue;
+
+            double neighborhoodValue;
+            //
+            // The neighborhood of zero width only contains the BMU
+            //
+            if (twoSigmaSquare > 0.0)
+                neighborhoodValue = std::exp(-distanceSquared / twoSigmaSquare);
+            else
+                neighborhoodValue = 1;
+            m_activations[row] = neighborhoodValue;
+            m_neighborhoodRows.append(row);
+
+            double* weights = m_inWeights.rowData(row);
+            double step = learningRate * neighborhoodValue;
+            for (int column = 0; column < columns; column++)
+                weights[column] += step * (input[column] - weights[column]);
+        }
+    }
+    syncNeuronValues();
+    syncInConnectionWeights(false);
+}
+
+//
+// Train the layer using the batch algorithm, which assigns all samples to their
+// BMUs and replaces every weight vector by the average of the samples weighted
+// by the neighborhood function of their BMUs.
+//
+// The samples are assigned in parallel, every thread summing the inputs of its
+// part of the samples in its own buffers. This thread takes the first part.
+//
+void KohonenOutputLayer::trainBatch(const QVector<TrainingSample>& samples, double sigma)
+{
+    const int rows = m_inWeights.rows();
+    const int columns = m_inWeights.columns();
+    const int count = samples.size();
+    if (count == 0 || rows == 0)
+        return;
+
+    if (m_batchBMUs.size() != count)
+        m_batchBMUs.fill(-1, count);
+    int* bmus = m_batchBMUs.data();
+
+    int threads = qBound(1, count / BatchChunkSize, qMax(1, QThread::idealThreadCount()));
+    int chunk = (count + threads - 1) / threads;
+
+    QVector<QFuture<BatchSums>> futures;
+    for (int begin = chunk; begin < count; begin += chunk) {
+        int end = qMin(begin + chunk, count);
+        futures.append(QtConcurrent::run([this, &samples, begin, end, bmus] {
+            return accumulateBatch(samples, begin, end, bmus);
+        }));
+    }
+    auto sums = accumulateBatch(samples, 0, qMin(chunk, count), bmus);
+    for (auto& future : futures) {
+        const auto partial = future.result();
+        VectorKernels::axpy(1.0, partial.inputs.constData(), sums.inputs.data(), rows * columns);
+        for (int row = 0; row < rows; row++)
+            sums.counts[row] += partial.counts.at(row);
+    }
+
+    //
+    // Neurons whose neighborhood contains no samples keep their weights
+    //
+    double twoSigmaSquare = 2 * sigma * sigma;
+    double cutoff = qMax(0.0, NeighborhoodCutoff * sigma);
+    double cutoffSquared = cutoff * cutoff;
+    int radius = static_cast<int>(qMin(cutoff, static_cast<double>(qMax(m_gridWidth, m_gridHeight))));
+
+    QVector<double> numerator(columns);
+    for (int row = 0; row < rows; row++) {
+        const QPoint& position = m_positions.at(row);
+        const int x0 = qMax(0, position.x() - radius);
+        const int x1 = qMin(m_gridWidth - 1, position.x() + radius);
+        const int y0 = qMax(0, position.y() - radius);
+        const int y1 = qMin(m_gridHeight - 1, position.y() + radius);
+
+        double denominator = 0.0;
+        numerator.fill(0.0);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                int other = m_grid.at(y * m_gridWidth + x);
+                if (other < 0 || sums.counts.at(other) == 0)
+                    continue;
+
+                int dx = position.x() - x;
+                int dy = position.y() - y;
+                double distanceSquared = dx * dx + dy * dy;
+                if (distanceSquared > cutoffSquared)
+                    continue;
+
+                double neighborhoodValue = 1;
+                if (twoSigmaSquare > 0.0)
+                    neighborhoodValue = std::exp(-distanceSquared / twoSigmaSquare);
+
+                VectorKernels::axpy(neighborhoodValue,
+                                    sums.inputs.constData() + other * columns,
+                                    numerator.data(),
+                                    columns);
+                denominator += neighborhoodValue * sums.counts.at(other);
+            }
+        }
+        if (denominator > 0.0) {
+            double* weights = m_inWeights.rowData(row);
+            for (int column = 0; column < columns; column++)
+                weights[column] = numerator.at(column) / denominator;
+        }
+    }
+    syncInConnectionWeights(false);
+}
+
+//
+// Assign the samples in the range [begin, end) to their BMUs and sum them, this
+// may run in any thread
+//
+KohonenOutputLayer::BatchSums KohonenOutputLayer::accumulateBatch(const QVector<TrainingSample>& samples,
+                                                                  int begin, int end,
+                                                                  int* bmus) const
+{
+    const int columns = m_inWeights.columns();
+
+    BatchSums sums;
+    sums.inputs.fill(0.0, m_inWeights.rows() * columns);
+    sums.counts.fill(0, m_inWeights.rows());
+    for (int i = begin; i < end; i++) {
+        const double* input = samples.at(i).inputs().constData();
+        int bmu = findBMU(input, nullptr, bmus[i]);
+
+        bmus[i] = bmu;
+        VectorKernels::axpy(1.0, input, sums.inputs.data() + bmu * columns, columns);
+        sums.counts[bmu]++;
+    }
+    return sums;
 }
 
 void KohonenOutputLayer::updateScenePosition(double inputWidth)
@@ -147,6 +500,19 @@ void KohonenOutputLayer::updateScenePosition(double inputWidth)
     if (height <= 0 || width <= 0)
         return;
 
+    if (m_mapItem != nullptr) {
+        //
+        // The map image fills the space next to the input layer
+        //
+        double side = qMin(width - inputWidth, height * 1.0) * .9;
+        double cellSize = side / qMax(m_gridWidth, m_gridHeight);
+        QRectF rect(0, 0, cellSize * m_gridWidth, cellSize * m_gridHeight);
+
+        m_mapItem->setRect(rect);
+        setBoundingRect(rect);
+        return;
+    }
+
     int neuronSideCount = std::sqrt(neuronCount());
 
     auto neuronSize = (qMin(width - inputWidth, height * 1.0) / neuronSideCount) * .3;
@@ -21,9 +21,14 @@
 
 #include "common.h"
 
+#include <QSize>
+
 #include "kohonenlayer.h"
 #include "kohonenoutputneuron.h"
 #include "savednetworklayer.h"
+#include "trainingsample.h"
+
+class KohonenMapItem;
 
 class KohonenOutputLayer : public KohonenLayer
 {
@@ -33,19 +38,77 @@ public:
     explicit KohonenOutputLayer(SavedNetworkLayer* layer, Network* parent);
 
     void computeAndSet();
+    void computeInto(const double* input, double* output) const;
     KohonenOutputNeuron* currentBMU() const;
+    int currentBMUIndex() const;
+    double initialSigma() const;
     KohonenOutputNeuron* kohonenOutputNeuron(int index) const;
-    void setLearningRate(double learningRate);
-    void train(int currentTrainingEpoch, int trainingEpochs);
+    QSize gridSize() const;
+    int gridNeuron(int x, int y) const;
+    bool isLargeMap() const;
+    QVector<double> neighborDistances() const;
+    void train(double learningRate, double sigma);
+    void trainBatch(const QVector<TrainingSample>& samples, double sigma);
     void updateScenePosition(double inputWidth);
 
+    bool hasInConnectionItems() const override;
+    void setShowNeuronValues(bool enabled) override;
+
+public slots:
+    void applyNeuronValues(const QVector<double>& values) override;
+
 protected:
     QString defaultNeuronName(int index) const override;
 
 private:
+    //
+    // Neurons farther from the BMU than this multiple of sigma are not updated,
+    // the neighborhood function is below 1.2 % there
+    //
+    static constexpr double NeighborhoodCutoff = 3.0;
+    //
+    // Minimal number of samples assigned to their BMUs by a single thread in
+    // the batch training
+    //
+    static constexpr int BatchChunkSize = 256;
+
+    //
+    // Sums of the inputs of the samples assigned to every neuron and the numbers
+    // of these samples
+    //
+    struct BatchSums {
+        QVector<double> inputs;
+        QVector<int> counts;
+    };
+
     void init();
+    BatchSums accumulateBatch(const QVector<TrainingSample>& samples, int begin, int end,
+                              int* bmus) const;
+    int findBMU(const double* input, double* squaredDistance = nullptr, int startIndex = -1) const;
     void updateBMU(double* bmuDistance = nullptr);
 
     KohonenOutputNeuron* m_bmu = nullptr;
-    double m_sigma;
+    int m_bmuIndex = -1;
+    double m_initialSigma;
+    QVector<QPoint> m_positions;
+    //
+    // Index of the neuron at each grid position, -1 for empty positions
+    //
+    QVector<int> m_grid;
+    int m_gridWidth = 0;
+    int m_gridHeight = 0;
+    //
+    // Neurons with a non-zero neighborhood value for the current sample
+    //
+    QVector<int> m_neighborhoodRows;
+    bool m_neighborhoodTracked = false;
+    //
+    // BMU of every training sample in the previous batch epoch, where the search
+    // of the next epoch starts
+    //
+    QVector<int> m_batchBMUs;
+    //
+    // Image of the whole map replacing the neuron items of a large map
+    //
+    KohonenMapItem* m_mapItem = nullptr;
 };
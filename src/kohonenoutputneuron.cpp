@@ -41,27 +41,6 @@ const QPoint& KohonenOutputNeuron::position() const
     return m_position;
 }
 
-//
-// Change output neuron learning rate
-//
-void KohonenOutputNeuron::setLearningRate(double learningRate)
-{
-    Q_ASSERT(learningRate > 0.0 && learningRate <= 1.0);
-
-    m_learningRate = learningRate;
-}
-
-void KohonenOutputNeuron::updateWeights()
-{
-    const auto& connections = inConnections();
-    for (auto* conn : connections) {
-        double weight = conn->weight();
-        weight += m_learningRate * value() * (conn->neuron1()->value() - weight);
-        conn->setWeight(weight);
-    }
-    update();
-}
-
 void KohonenOutputNeuron::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
     Q_UNUSED(option);
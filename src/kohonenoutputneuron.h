@@ -36,11 +36,8 @@ public:
 
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
     const QPoint& position() const;
-    void setLearningRate(double learningRate);
-    void updateWeights();
 
 private:
     QRectF m_boundingRect;
     QPoint m_position;
-    double m_learningRate = 1.0;
 };
@@ -0,0 +1,64 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "kohonenschedule.h"
+
+#include <cmath>
+
+//
+// Return the training progress in the range [0, 1], without a limit on the
+// number of epochs the schedules keep their initial value
+//
+double KohonenSchedule::progress(int trainingEpoch, int maxEpochs)
+{
+    if (maxEpochs <= 0)
+        return 0.0;
+
+    return qBound(0.0, static_cast<double>(trainingEpoch) / maxEpochs, 1.0);
+}
+
+double KohonenSchedule::value(NetworkInfo::Schedule schedule, double initialValue, double progress)
+{
+    switch (schedule) {
+        case NetworkInfo::Schedule::Constant:
+            return initialValue;
+        case NetworkInfo::Schedule::Linear:
+            return initialValue * (1.0 - progress);
+        case NetworkInfo::Schedule::Exponential:
+            return initialValue * std::pow(FinalRatio, progress);
+        case NetworkInfo::Schedule::InverseTime:
+            //
+            // Reaches the final ratio at the end of the training
+            //
+            return initialValue / (1.0 + progress * (1.0 / FinalRatio - 1.0));
+        case NetworkInfo::Schedule::Piecewise: {
+            double ratio;
+            if (progress < OrderingPhaseProgress)
+                ratio = 1.0 - (1.0 - OrderingPhaseRatio) * progress / OrderingPhaseProgress;
+            else
+                ratio = OrderingPhaseRatio - (OrderingPhaseRatio - FinalRatio)
+                        * (progress - OrderingPhaseProgress) / (1.0 - OrderingPhaseProgress);
+            return initialValue * ratio;
+        }
+        default:
+            Q_ASSERT(false);
+            break;
+    }
+    return initialValue;
+}
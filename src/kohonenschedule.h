@@ -0,0 +1,48 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include "networkinfo.h"
+
+//
+// Schedules of the learning rate and of the neighborhood radius used to train
+// the Kohonen network.
+//
+// The value of a schedule depends on the training progress, which is the ratio
+// of the current training epoch to the maximal number of epochs.
+//
+namespace KohonenSchedule {
+    //
+    // Ratio of the final and the initial value of the exponential, inverse-time
+    // and piecewise schedules
+    //
+    static constexpr double FinalRatio = 0.01;
+    //
+    // The piecewise schedule first quickly orders the map and then slowly
+    // converges, the ordering phase ends at this progress with this ratio
+    //
+    static constexpr double OrderingPhaseProgress = 0.1;
+    static constexpr double OrderingPhaseRatio = 0.1;
+
+    double progress(int trainingEpoch, int maxEpochs);
+    double value(NetworkInfo::Schedule schedule, double initialValue, double progress);
+}
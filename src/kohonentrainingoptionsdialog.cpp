@@ -20,6 +20,8 @@
 #include "kohonentrainingoptionsdialog.h"
 #include "ui_kohonentrainingoptionsdialog.h"
 
+#include "kohonennetwork.h"
+
 KohonenTrainingOptionsDialog::KohonenTrainingOptionsDialog(Network* network, QWidget* parent) :
     QDialog(parent),
     ui(new Ui::KohonenTrainingOptionsDialog),
@@ -41,6 +43,9 @@ void KohonenTrainingOptionsDialog::init()
     if (m_network->isTraining() || m_network->isTrainingPaused()) {
         ui->editLearningRate->setReadOnly(true);
         ui->editMaxEpochs->setReadOnly(true);
+        ui->comboBoxLearningRateSchedule->setEnabled(false);
+        ui->comboBoxNeighborhoodSchedule->setEnabled(false);
+        ui->comboBoxTrainingMode->setEnabled(false);
         ui->labelTraining->show();
     } else
         ui->labelTraining->hide();
@@ -60,6 +65,17 @@ void KohonenTrainingOptionsDialog::init()
     ui->comboBoxSampleSelectionOrder->addItems(NetworkInfo::sampleSelectionOrderStringList());
     if (map.contains(NetworkInfo::Key::SampleSelectionOrder))
         ui->comboBoxSampleSelectionOrder->setCurrentIndex(NetworkInfo::sampleSelectionOrderIndexFromMap(map));
+
+    auto* kohonenNetwork = qobject_cast<KohonenNetwork*>(m_network);
+    ui->comboBoxTrainingMode->addItems(NetworkInfo::kohonenTrainingModeStringList());
+    ui->comboBoxTrainingMode->setCurrentIndex(
+                NetworkInfo::kohonenTrainingModeToIndex(kohonenNetwork->trainingMode()));
+    ui->comboBoxLearningRateSchedule->addItems(NetworkInfo::scheduleStringList());
+    ui->comboBoxLearningRateSchedule->setCurrentIndex(
+                NetworkInfo::scheduleToIndex(kohonenNetwork->learningRateSchedule()));
+    ui->comboBoxNeighborhoodSchedule->addItems(NetworkInfo::scheduleStringList());
+    ui->comboBoxNeighborhoodSchedule->setCurrentIndex(
+                NetworkInfo::scheduleToIndex(kohonenNetwork->neighborhoodSchedule()));
 }
 
 void KohonenTrainingOptionsDialog::accept()
@@ -72,5 +88,30 @@ void KohonenTrainingOptionsDialog::accept()
                 NetworkInfo::sampleSelectionOrderFromIndex(
                     ui->comboBoxSampleSelectionOrder->currentIndex()));
 
+    auto* kohonenNetwork = qobject_cast<KohonenNetwork*>(m_network);
+    kohonenNetwork->setTrainingMode(
+                NetworkInfo::kohonenTrainingModeFromIndex(
+                    ui->comboBoxTrainingMode->currentIndex()));
+    kohonenNetwork->setLearningRateSchedule(
+                NetworkInfo::scheduleFromIndex(
+                    ui->comboBoxLearningRateSchedule->currentIndex()));
+    kohonenNetwork->setNeighborhoodSchedule(
+                NetworkInfo::scheduleFromIndex(
+                    ui->comboBoxNeighborhoodSchedule->currentIndex()));
+
     QDialog::accept();
 }
+
+void KohonenTrainingOptionsDialog::on_comboBoxTrainingMode_currentIndexChanged(int index)
+{
+    if (m_network->isTraining() || m_network->isTrainingPaused())
+        return;
+    //
+    // The batch training does not use the learning rate
+    //
+    bool online = NetworkInfo::kohonenTrainingModeFromIndex(index)
+            == NetworkInfo::KohonenTrainingMode::Online;
+
+    ui->editLearningRate->setEnabled(online);
+    ui->comboBoxLearningRateSchedule->setEnabled(online);
+}
@@ -38,6 +38,9 @@ public:
 
     void accept() override;
 
+private slots:
+    void on_comboBoxTrainingMode_currentIndexChanged(int index);
+
 private:
     void init();
 
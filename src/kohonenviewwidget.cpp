@@ -19,6 +19,8 @@
  */
 #include "kohonenviewwidget.h"
 
+#include <QWheelEvent>
+
 #include "kohonentrainingoptionsdialog.h"
 #include "kohonenweightchartwidget.h"
 #include "kohonennetwork.h"
@@ -51,6 +53,9 @@ void KohonenViewWidget::init()
     });
 
     NetworkViewWidget::setShowConnectionWeights(false);
+
+    ui->diagram->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    ui->diagram->viewport()->installEventFilter(this);
 }
 
 QVector<MainDockWidget*> KohonenViewWidget::createDockWidgets()
@@ -101,3 +106,22 @@ void KohonenViewWidget::setShowConnectionWeights(bool enabled)
 {
     Q_UNUSED(enabled);
 }
+
+//
+// Zoom the diagram with the mouse wheel while the Ctrl key is held
+//
+bool KohonenViewWidget::eventFilter(QObject* obj, QEvent* event)
+{
+    if (event->type() == QEvent::Wheel && obj == ui->diagram->viewport()) {
+        auto* wheelEvent = static_cast<QWheelEvent*>(event);
+        if (wheelEvent->modifiers() & Qt::ControlModifier) {
+            double zoom = ui->diagram->transform().m11();
+            double factor = (wheelEvent->angleDelta().y() > 0) ? ZoomStep : 1 / ZoomStep;
+            double newZoom = qBound(1.0, zoom * factor, static_cast<double>(MaxZoom));
+
+            ui->diagram->scale(newZoom / zoom, newZoom / zoom);
+            return true;
+        }
+    }
+    return NetworkViewWidget::eventFilter(obj, event);
+}
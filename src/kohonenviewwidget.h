@@ -40,6 +40,15 @@ public:
     bool showConnectionWeights() const override;
     void setShowConnectionWeights(bool enabled) override;
 
+protected:
+    bool eventFilter(QObject* obj, QEvent* event) override;
+
 private:
+    //
+    // Zoom limits of the diagram, large maps may be zoomed in to show details
+    //
+    static constexpr double MaxZoom = 64.0;
+    static constexpr double ZoomStep = 1.25;
+
     void init();
 };
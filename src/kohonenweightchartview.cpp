@@ -110,7 +110,7 @@ void KohonenWeightChartView::init()
             updateRange();
         }
     });
-    connect(m_network, &Network::neuronWeightChanged, this, [this] {
+    connect(m_network, &Network::weightsUpdated, this, [this] {
         //
         // Handle weight changes when the network is not being trained. This happens
         // when it's changed manually by the user and it should be reflected by
@@ -173,10 +173,8 @@ void KohonenWeightChartView::populateNeurons()
     m_neuronPointMap.clear();
 
     for (int i = 0; i < m_outputLayer->neuronCount(); i++) {
-        auto* neuron = m_outputLayer->neuron(i);
-
-        double x = neuron->inConnection(m_weightIndex1)->weight();
-        double y = neuron->inConnection(m_weightIndex2)->weight();
+        double x = m_outputLayer->neuronInWeight(i, m_weightIndex1);
+        double y = m_outputLayer->neuronInWeight(i, m_weightIndex2);
         m_neuronMinX = qMin(m_neuronMinX, x);
         m_neuronMaxX = qMax(m_neuronMaxX, x);
         m_neuronMinY = qMin(m_neuronMinY, y);
@@ -209,12 +207,12 @@ void KohonenWeightChartView::updateCurrentNeuron()
     if (m_currentInputPoint.isNull())
         return;
 
-    auto* bmu = m_outputLayer->currentBMU();
-    if (bmu == nullptr)
+    int bmuIndex = m_outputLayer->currentBMUIndex();
+    if (bmuIndex < 0)
         return;
 
-    double x = bmu->inConnection(m_weightIndex1)->weight();
-    double y = bmu->inConnection(m_weightIndex2)->weight();
+    double x = m_outputLayer->neuronInWeight(bmuIndex, m_weightIndex1);
+    double y = m_outputLayer->neuronInWeight(bmuIndex, m_weightIndex2);
     m_currentNeuronSeries->append(x, y);
 }
 
@@ -0,0 +1,141 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "leastsquares.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "vectorkernels.h"
+
+LeastSquares::LeastSquares(int inputs, int outputs) :
+    m_inputs(inputs),
+    m_outputs(outputs),
+    m_size(inputs + 1),
+    m_gram(m_size * m_size, 0.0),
+    m_moments(m_size * outputs, 0.0),
+    m_extendedInput(m_size)
+{
+    Q_ASSERT(inputs >= 0 && outputs > 0);
+
+    m_extendedInput[0] = 1.0;
+}
+
+void LeastSquares::addSample(const double* input, const double* target)
+{
+    double* x = m_extendedInput.data();
+    std::memcpy(x + 1, input, m_inputs * sizeof(double));
+
+    for (int i = 0; i < m_size; i++) {
+        VectorKernels::axpy(x[i], x, m_gram.data() + i * m_size, i + 1);
+        VectorKernels::axpy(x[i], target, m_moments.data() + i * m_outputs, m_outputs);
+    }
+    m_sampleCount++;
+}
+
+int LeastSquares::sampleCount() const
+{
+    return m_sampleCount;
+}
+
+//
+// Store the weights minimizing the sum of the squared errors into the matrix,
+// whose rows are the outputs and columns the inputs.
+//
+// Returns false if there are no samples or the equations cannot be solved.
+//
+bool LeastSquares::solve(double ridge, NetworkWeightMatrix& weights) const
+{
+    Q_ASSERT(weights.rows() == m_outputs && weights.columns() == m_inputs && weights.hasBias());
+
+    if (m_sampleCount == 0)
+        return false;
+
+    double maxDiagonal = 0.0;
+    for (int i = 0; i < m_size; i++)
+        maxDiagonal = qMax(maxDiagonal, m_gram.at(i * m_size + i));
+    //
+    // Smaller pivots are lost in the rounding errors, the equations are singular then
+    //
+    const double minPivot = maxDiagonal * m_size * std::numeric_limits<double>::epsilon();
+
+    QVector<double> matrix;
+    double regularization = 0.0;
+    for (int attempt = 0; ; attempt++) {
+        matrix = m_gram;
+        for (int i = 0; i < m_size; i++)
+            matrix[i * m_size + i] += regularization + (i > 0 ? ridge : 0.0);
+        if (decompose(matrix, minPivot))
+            break;
+        if (attempt == SingularAttempts)
+            return false;
+
+        regularization = (regularization > 0.0)
+                ? regularization * 10
+                : maxDiagonal * SingularRegularization;
+        if (regularization <= 0.0)
+            return false;
+    }
+
+    //
+    // Solve L * transpose(L) * w = b for the weights of every output
+    //
+    QVector<double> w(m_size);
+    for (int output = 0; output < m_outputs; output++) {
+        for (int i = 0; i < m_size; i++) {
+            double sum = m_moments.at(i * m_outputs + output);
+            for (int j = 0; j < i; j++)
+                sum -= matrix.at(i * m_size + j) * w.at(j);
+            w[i] = sum / matrix.at(i * m_size + i);
+        }
+        for (int i = m_size - 1; i >= 0; i--) {
+            double sum = w.at(i);
+            for (int j = i + 1; j < m_size; j++)
+                sum -= matrix.at(j * m_size + i) * w.at(j);
+            w[i] = sum / matrix.at(i * m_size + i);
+        }
+        weights.setBias(output, w.at(0));
+        std::memcpy(weights.rowData(output), w.constData() + 1, m_inputs * sizeof(double));
+    }
+    return true;
+}
+
+//
+// Replace the lower triangle of the symmetric matrix by its Cholesky factor,
+// returns false if a pivot is not greater than the given value
+//
+bool LeastSquares::decompose(QVector<double>& matrix, double minPivot) const
+{
+    double* a = matrix.data();
+
+    for (int j = 0; j < m_size; j++) {
+        double diagonal = a[j * m_size + j] - VectorKernels::dot(a + j * m_size, a + j * m_size, j);
+        if (!(diagonal > minPivot))
+            return false;
+
+        diagonal = std::sqrt(diagonal);
+        a[j * m_size + j] = diagonal;
+        for (int i = j + 1; i < m_size; i++) {
+            double value = a[i * m_size + j] - VectorKernels::dot(a + i * m_size, a + j * m_size, j);
+            a[i * m_size + j] = value / diagonal;
+        }
+    }
+    return true;
+}
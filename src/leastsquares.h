@@ -0,0 +1,68 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QVector>
+
+#include "networkweightmatrix.h"
+
+//
+// Linear least squares fit of the incoming weights of a layer whose outputs are
+// linear combinations of its inputs and a bias.
+//
+// The samples are accumulated into the normal equations in a single pass, which
+// are then solved using the Cholesky decomposition. The optional ridge
+// regularization adds the given value to the diagonal of the equations of all
+// weights except the bias.
+//
+class LeastSquares
+{
+public:
+    LeastSquares(int inputs, int outputs);
+
+    void addSample(const double* input, const double* target);
+    int sampleCount() const;
+    bool solve(double ridge, NetworkWeightMatrix& weights) const;
+
+private:
+    //
+    // When the equations are singular, a multiple of their largest diagonal value
+    // starting at this fraction is added to the diagonal, growing tenfold up to the
+    // given number of times
+    //
+    static constexpr double SingularRegularization = 1e-12;
+    static constexpr int SingularAttempts = 8;
+
+    bool decompose(QVector<double>& matrix, double minPivot) const;
+
+    int m_inputs;
+    int m_outputs;
+    int m_size;
+    int m_sampleCount = 0;
+    //
+    // Lower triangle of the sum of the outer products of the inputs extended by a
+    // leading 1 for the bias, and the sums of their products with the targets
+    //
+    QVector<double> m_gram;
+    QVector<double> m_moments;
+    QVector<double> m_extendedInput;
+};
@@ -24,6 +24,7 @@
 #include <QLocale>
 
 #include "mainwindow.h"
+#include "precisionbenchmark.h"
 #include "program.h"
 #include "version.h"
 
@@ -44,8 +45,21 @@ int main(int argc, char *argv[])
     parser.addHelpOption();
     parser.addVersionOption();
     parser.addPositionalArgument("file", QObject::tr("The file(s) to open."));
+    QCommandLineOption benchmarkOption("benchmark-precision",
+            QObject::tr("Compare the double and single evaluation precision on the "
+                        "given network files or the built-in examples, then exit."));
+    parser.addOption(benchmarkOption);
     parser.process(a);
 
+    if (parser.isSet(benchmarkOption)) {
+        auto files = parser.positionalArguments();
+        if (files.isEmpty())
+            files = PrecisionBenchmark::defaultFiles();
+
+        PrecisionBenchmark benchmark;
+        return benchmark.run(files) ? 0 : 1;
+    }
+
     a.setWindowIcon(QIcon(":/icons/nnlv.svg"));
 
     bool hasNetwork = false;
@@ -606,6 +606,12 @@ void MainWindow::setNetworkWidget(NetworkViewWidget* widget)
                 textReason = tr("%n epoch(s) done", "",
                                 network->trainingEpochs());
                 break;
+            case Network::StopTrainingReason::WeightsSolved:
+                textReason = tr("output weights solved"
+                                "\n\n"
+                                "Current error: %1")
+                             .arg(supervisedNetwork->error());
+                break;
             default:
                 break;
         }
@@ -743,12 +749,12 @@ void MainWindow::updateNetworkChangeConnections()
         disconnect(m_markModifiedWeightsConnection);
     if (markModified)
         m_markModifiedWeightsConnection =
-                connect(network, &Network::neuronWeightChanged, this, [this] {
+                connect(network, &Network::weightsUpdated, this, [this] {
                     setModified(true);
                 });
     else
         m_markModifiedWeightsConnection =
-                connect(network, &Network::neuronWeightChanged, this, [this] {
+                connect(network, &Network::weightsUpdated, this, [this] {
                     //
                     // User requested not to mark the window as modified, but the
                     // network has changes and it should be possible to save it
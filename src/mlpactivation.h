@@ -39,6 +39,20 @@ public:
     };
     Q_ENUM(Function)
 
+    //
+    // Precision of the activation functions used by the layers, the fast mode
+    // uses approximations whose error bounds are described in mlpactivationkernels.h
+    //
+    enum class Precision {
+        //
+        // The "Unknown" precision is used as an error indicator
+        //
+        Unknown,
+        Exact,
+        Fast
+    };
+    Q_ENUM(Precision)
+
     static double sigmoid(double x) {
         return 1.0 / (1.0 + std::exp(-x));
     }
@@ -136,6 +150,81 @@ public:
 
         return -1;
     }
+
+    //
+    // Retrieve a list of activation precisions
+    //
+    static QStringList precisionStringList() {
+        auto list = QStringList();
+        list << QObject::tr("Exact");
+        list << QObject::tr("Fast approximation");
+        return list;
+    }
+
+    //
+    // Convert between activation precision order and index
+    //
+    static Precision precisionFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return Precision::Exact;
+            case 1:
+                return Precision::Fast;
+            default:
+                break;
+        }
+        return Precision::Unknown;
+    }
+    static int precisionToIndex(Precision precision) {
+        switch (precision) {
+            case Precision::Exact:
+                return 0;
+            case Precision::Fast:
+                return 1;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert activation precision name string to enum constant
+    //
+    static Precision precisionFromString(const QString& precisionString) {
+        QString precisionLower = precisionString.toLower();
+        if (precisionLower == "exact")
+            return Precision::Exact;
+        else if (precisionLower == "fast")
+            return Precision::Fast;
+        return Precision::Unknown;
+    }
+    //
+    // Convert activation precision constant to string
+    //
+    static QString precisionToString(Precision precision) {
+        switch (precision) {
+            case Precision::Exact:
+                return "exact";
+            case Precision::Fast:
+                return "fast";
+            case Precision::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    static Precision precisionFromMap(const NetworkInfo::Map& map) {
+        if (map.contains(NetworkInfo::Key::ActivationPrecision))
+            return map.value(NetworkInfo::Key::ActivationPrecision).value<Precision>();
+
+        return Precision::Unknown;
+    }
+    static int precisionIndexFromMap(const NetworkInfo::Map& map) {
+        if (map.contains(NetworkInfo::Key::ActivationPrecision))
+            return precisionToIndex(precisionFromMap(map));
+
+        return -1;
+    }
 };
 
 class MLPActivationDerivative {
@@ -0,0 +1,133 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "mlpactivationkernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// ===
+// Activation functions
+// ===
+
+struct Sigmoid {
+    template<typename T>
+    static T value(T x) {
+        return T(1) / (T(1) + std::exp(-x));
+    }
+    static double derivative(double y) {
+        return MLPActivationDerivative::sigmoid(y);
+    }
+};
+
+struct Tanh {
+    template<typename T>
+    static T value(T x) {
+        return std::tanh(x);
+    }
+    static double derivative(double y) {
+        return MLPActivationDerivative::tanh(y);
+    }
+};
+
+//
+// Beyond this limit the approximant starts to exceed 1, the error of the
+// clamped value stays below the error bound
+//
+constexpr double FastTanhLimit = 6.2;
+
+template<typename T>
+inline T fastTanh(T x)
+{
+    x = std::min(std::max(x, T(-FastTanhLimit)), T(FastTanhLimit));
+
+    const T x2 = x * x;
+    const T p = x * (T(34459425) + x2 * (T(4729725) + x2 * (T(135135) + x2 * (T(990) + x2))));
+    const T q = T(34459425) + x2 * (T(16216200) + x2 * (T(945945) + x2 * (T(13860) + x2 * T(45))));
+    return p / q;
+}
+
+struct FastSigmoid {
+    template<typename T>
+    static T value(T x) {
+        return T(0.5) + T(0.5) * fastTanh(T(0.5) * x);
+    }
+    static double derivative(double y) {
+        return MLPActivationDerivative::sigmoid(y);
+    }
+};
+
+struct FastTanh {
+    template<typename T>
+    static T value(T x) {
+        return fastTanh(x);
+    }
+    static double derivative(double y) {
+        return MLPActivationDerivative::tanh(y);
+    }
+};
+
+// ===
+// Layer loops
+// ===
+
+template<typename Activation, typename T>
+void activate(T* values, const T* bias, int size)
+{
+    for (int i = 0; i < size; i++)
+        values[i] = Activation::value(values[i] + bias[i]);
+}
+
+template<typename Activation>
+void multiplyDerivative(const double* activations, double* deltas, int size)
+{
+    for (int i = 0; i < size; i++)
+        deltas[i] *= Activation::derivative(activations[i]);
+}
+
+template<typename Activation>
+const MLPActivationKernels::Kernels& kernelsFor()
+{
+    static const MLPActivationKernels::Kernels kernels = {
+        activate<Activation, double>,
+        activate<Activation, float>,
+        multiplyDerivative<Activation>
+    };
+    return kernels;
+}
+
+} // namespace
+
+const MLPActivationKernels::Kernels& MLPActivationKernels::kernels(MLPActivation::Function function,
+                                                                   MLPActivation::Precision precision)
+{
+    const bool fast = (precision == MLPActivation::Precision::Fast);
+
+    switch (function) {
+        case MLPActivation::Function::Sigmoid:
+            return fast ? kernelsFor<FastSigmoid>() : kernelsFor<Sigmoid>();
+        case MLPActivation::Function::Tanh:
+            return fast ? kernelsFor<FastTanh>() : kernelsFor<Tanh>();
+        default:
+            Q_UNREACHABLE();
+            return kernelsFor<Sigmoid>();
+    }
+}
@@ -19,8 +19,11 @@
  */
 #include "mlplayer.h"
 
+#include <algorithm>
+
 #include "mlpbiasneuron.h"
 #include "mlpneuron.h"
+#include "vectorkernels.h"
 
 MLPLayer::MLPLayer(NetworkLayerInfo::Type type, Network* parent) :
     SLPLayer(type, parent)
@@ -42,25 +45,19 @@ QString MLPLayer::defaultNeuronName(int index) const
 
 QVector<double> MLPLayer::compute(const QVector<double>& input) const
 {
-    QVector<double> output;
+    Q_ASSERT(input.size() == m_inWeights.columns());
 
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = mlpNeuron(i);
-        // Skip the bias
-        if (neuron != nullptr)
-            output.append(neuron->compute(input));
-    }
+    QVector<double> output(m_inWeights.rows());
+    computeInto(input.constData(), output.data());
     return output;
 }
 
 void MLPLayer::computeAndSet(const QVector<double>& input)
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = mlpNeuron(i);
-        // Skip the bias
-        if (neuron != nullptr)
-            neuron->setValue(neuron->compute(input));
-    }
+    Q_ASSERT(input.size() == m_inWeights.columns());
+
+    computeInto(input.constData(), m_activations.data());
+    syncNeuronValues();
 }
 
 //
@@ -69,12 +66,55 @@ void MLPLayer::computeAndSet(const QVector<double>& input)
 //
 void MLPLayer::forward()
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = mlpNeuron(i);
-        // Skip the bias
-        if (neuron != nullptr)
-            neuron->forward();
-    }
+    const auto* layer = previousLayer();
+    Q_ASSERT(layer != nullptr);
+
+    computeInto(layer->activations().constData(), m_activations.data());
+    syncNeuronValues();
+}
+
+//
+// Compute the output values of the non-bias neurons for the given values of the
+// non-bias neurons in the previous layer
+//
+void MLPLayer::computeInto(const double* input, double* output) const
+{
+    const int columns = m_inWeights.columns();
+    const int rows = m_inWeights.rows();
+    const double* bias = m_inWeights.biasData();
+
+    for (int row = 0; row < rows; row++)
+        output[row] = VectorKernels::dot(input, m_inWeights.rowData(row), columns);
+
+    m_activationKernels->activate(output, bias, rows);
+}
+
+//
+// Compute the output values for a batch of samples stored as rows of the input
+//
+void MLPLayer::computeBatchInto(const double* input, int count, double* output) const
+{
+    const int rows = m_inWeights.rows();
+    const double* bias = m_inWeights.biasData();
+
+    VectorKernels::multiplyTransposed(input, count, m_inWeights.rowData(0), rows,
+                                      m_inWeights.columns(), output);
+    for (int i = 0; i < count; i++)
+        m_activationKernels->activate(output + i * rows, bias, rows);
+}
+
+//
+// Compute the output values for a batch of samples using the single-precision weights
+//
+void MLPLayer::computeBatchInto(const float* input, int count, float* output) const
+{
+    const int rows = m_singleInWeights.rows();
+    const float* bias = m_singleInWeights.biasData();
+
+    VectorKernels::multiplyTransposed(input, count, m_singleInWeights.rowData(0), rows,
+                                      m_singleInWeights.columns(), output);
+    for (int i = 0; i < count; i++)
+        m_activationKernels->activateSingle(output + i * rows, bias, rows);
 }
 
 MLPNeuron* MLPLayer::mlpNeuron(int index) const
@@ -86,6 +126,11 @@ void MLPLayer::setActivationFunction(MLPActivation::Function function)
 {
     Q_ASSERT(function != MLPActivation::Function::Unknown);
 
+    m_activationFunction = function;
+    m_activationKernels = &MLPActivationKernels::kernels(m_activationFunction, m_activationPrecision);
+    //
+    // Neurons only use the function to pick the range of colors
+    //
     for (int i = 0; i < neuronCount(); i++) {
         auto* neuron = mlpNeuron(i);
         if (neuron != nullptr)
@@ -93,34 +138,172 @@ void MLPLayer::setActivationFunction(MLPActivation::Function function)
     }
 }
 
+void MLPLayer::setActivationPrecision(MLPActivation::Precision precision)
+{
+    Q_ASSERT(precision != MLPActivation::Precision::Unknown);
+
+    m_activationPrecision = precision;
+    m_activationKernels = &MLPActivationKernels::kernels(m_activationFunction, m_activationPrecision);
+}
+
 void MLPLayer::setLearningRate(double learningRate)
 {
     Q_ASSERT(learningRate > 0.0 && learningRate <= 1.0);
 
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = mlpNeuron(i);
-        if (neuron != nullptr)
-            neuron->setLearningRate(learningRate);
-    }
+    m_optimizer.setLearningRate(learningRate);
+}
+
+void MLPLayer::setOptimizer(NetworkInfo::Optimizer optimizer)
+{
+    m_optimizer.setType(optimizer);
+}
+
+//
+// Drop the state of the optimizer, this is done before the training starts
+//
+void MLPLayer::resetOptimizer()
+{
+    m_optimizer.reset();
 }
 
+//
+// Propagate the deltas of the next layer back to this layer
+//
 void MLPLayer::updateDelta()
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = mlpNeuron(i);
-        // Skip the bias
-        if (neuron != nullptr)
-            neuron->updateDelta();
+    const auto* next = qobject_cast<const MLPLayer*>(nextLayer());
+    Q_ASSERT(next != nullptr);
+
+    const auto& nextWeights = next->inWeights();
+    const int columns = nextWeights.columns();
+
+    m_deltas.fill(0.0, columns);
+    for (int row = 0; row < nextWeights.rows(); row++) {
+        const double* weights = nextWeights.rowData(row);
+        const double delta = next->m_deltas.at(row);
+
+        VectorKernels::axpy(delta, weights, m_deltas.data(), columns);
     }
+    m_activationKernels->multiplyDerivative(m_activations.constData(), m_deltas.data(), columns);
 }
 
+//
+// Update the weights of the input connections
+//
 void MLPLayer::updateWeights()
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = mlpNeuron(i);
-        // Skip the bias
-        if (neuron != nullptr)
-            neuron->updateWeights();
+    const auto* layer = previousLayer();
+    Q_ASSERT(layer != nullptr);
+
+    const double* input = layer->activations().constData();
+
+    m_optimizer.beginUpdate(m_inWeights);
+    for (int row = 0; row < m_inWeights.rows(); row++)
+        m_optimizer.updateRow(m_inWeights, row, m_deltas.at(row), input);
+
+    syncInConnectionWeights();
+}
+
+//
+// Store the inputs and deltas of the current sample for the next weight update
+//
+void MLPLayer::accumulateBatch()
+{
+    const auto* layer = previousLayer();
+    Q_ASSERT(layer != nullptr);
+
+    const auto& input = layer->activations();
+    const int columns = m_inWeights.columns();
+    const int rows = m_inWeights.rows();
+
+    m_batchInputs.resize((m_batchSamples + 1) * columns);
+    m_batchDeltas.resize((m_batchSamples + 1) * rows);
+
+    std::copy(input.constBegin(), input.constEnd(),
+              m_batchInputs.begin() + m_batchSamples * columns);
+    std::copy(m_deltas.constBegin(), m_deltas.constBegin() + rows,
+              m_batchDeltas.begin() + m_batchSamples * rows);
+    m_batchSamples++;
+}
+
+//
+// Update the weights of the input connections using the average gradient of the
+// samples accumulated since the last update.
+//
+// This computes the product of the transposed batch delta matrix and the batch
+// input matrix, one weight row at a time.
+//
+void MLPLayer::applyBatch()
+{
+    if (m_batchSamples == 0)
+        return;
+
+    if (!m_optimizer.isStateless()) {
+        applyBatchGradient();
+        return;
+    }
+    const int columns = m_inWeights.columns();
+    const int rows = m_inWeights.rows();
+    const double scale = m_optimizer.learningRate() / m_batchSamples;
+    double* bias = m_inWeights.biasData();
+
+    for (int row = 0; row < rows; row++) {
+        double* weights = m_inWeights.rowData(row);
+        double biasStep = 0.0;
+
+        for (int sample = 0; sample < m_batchSamples; sample++) {
+            const double step = scale * m_batchDeltas.at(sample * rows + row);
+            if (step == 0.0)
+                continue;
+
+            const double* input = m_batchInputs.constData() + sample * columns;
+            VectorKernels::axpy(-step, input, weights, columns);
+            biasStep += step;
+        }
+        if (m_inWeights.hasBias())
+            bias[row] -= biasStep;
+    }
+    resetBatch();
+    syncInConnectionWeights();
+}
+
+//
+// Update the weights using the average gradient of the accumulated samples and
+// the adaptive optimizer, which needs the whole gradient of each weight row
+//
+void MLPLayer::applyBatchGradient()
+{
+    const int columns = m_inWeights.columns();
+    const int rows = m_inWeights.rows();
+    const double scale = 1.0 / m_batchSamples;
+
+    m_gradient.resize(columns);
+    m_optimizer.beginUpdate(m_inWeights);
+    for (int row = 0; row < rows; row++) {
+        double biasGradient = 0.0;
+
+        m_gradient.fill(0.0);
+        for (int sample = 0; sample < m_batchSamples; sample++) {
+            const double delta = scale * m_batchDeltas.at(sample * rows + row);
+            if (delta == 0.0)
+                continue;
+
+            const double* input = m_batchInputs.constData() + sample * columns;
+            VectorKernels::axpy(delta, input, m_gradient.data(), columns);
+            biasGradient += delta;
+        }
+        m_optimizer.updateRow(m_inWeights, row, m_gradient.constData(), biasGradient);
     }
-    updateInConnectionRange();
+    resetBatch();
+    syncInConnectionWeights();
+}
+
+//
+// Drop the accumulated samples, the allocated memory is kept for the next batch
+//
+void MLPLayer::resetBatch()
+{
+    m_batchInputs.resize(0);
+    m_batchDeltas.resize(0);
+    m_batchSamples = 0;
 }
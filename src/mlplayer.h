@@ -22,7 +22,9 @@
 #include "common.h"
 
 #include "mlpactivation.h"
+#include "mlpactivationkernels.h"
 #include "mlpneuron.h"
+#include "networkoptimizer.h"
 #include "savednetworklayer.h"
 #include "slplayer.h"
 
@@ -35,13 +37,48 @@ public:
 
     QVector<double> compute(const QVector<double>& input) const override;
     void computeAndSet(const QVector<double>& input);
+    void computeInto(const double* input, double* output) const;
+    void computeBatchInto(const double* input, int count, double* output) const;
+    void computeBatchInto(const float* input, int count, float* output) const;
     void forward();
     MLPNeuron* mlpNeuron(int index) const;
     void setActivationFunction(MLPActivation::Function function);
+    void setActivationPrecision(MLPActivation::Precision precision);
     void setLearningRate(double learningRate);
+    void setOptimizer(NetworkInfo::Optimizer optimizer);
+    void resetOptimizer();
     void updateDelta();
     void updateWeights();
 
+    void accumulateBatch();
+    void applyBatch();
+    void resetBatch();
+
 protected:
     virtual QString defaultNeuronName(int index) const override;
+
+    MLPActivation::Function m_activationFunction = MLPActivation::Function::Sigmoid;
+    MLPActivation::Precision m_activationPrecision = MLPActivation::Precision::Exact;
+    //
+    // Kernels of the current activation function and precision
+    //
+    const MLPActivationKernels::Kernels* m_activationKernels =
+            &MLPActivationKernels::kernels(m_activationFunction, m_activationPrecision);
+    NetworkOptimizer m_optimizer;
+    QVector<double> m_deltas;
+
+private:
+    void applyBatchGradient();
+
+    //
+    // Inputs and deltas of the samples of the current mini-batch, one row
+    // per sample
+    //
+    QVector<double> m_batchInputs;
+    QVector<double> m_batchDeltas;
+    int m_batchSamples = 0;
+    //
+    // Average gradient of a weight row, used by the adaptive optimizers
+    //
+    QVector<double> m_gradient;
 };
@@ -19,6 +19,8 @@
  */
 #include "mlpnetwork.h"
 
+#include <QMutexLocker>
+
 #include "graphicsutilities.h"
 #include "mlphiddenlayer.h"
 #include "mlpinputlayer.h"
@@ -47,7 +49,10 @@ MLPNetwork::MLPNetwork(const NetworkInfo::Map& map, QObject* parent) :
         auto* hiddenLayer = new MLPHiddenLayer(hiddenCountList[i], i + 1, this);
 
         hiddenLayer->setInitialWeightFunction(weightFunction);
+        hiddenLayer->setActivationFunction(MLPActivation::functionFromMap(m_infoMap));
+        hiddenLayer->setActivationPrecision(activationPrecision());
         hiddenLayer->setLearningRate(learningRate());
+        hiddenLayer->setOptimizer(optimizer());
         addLayer(hiddenLayer);
 
         lastLayer->connectTo(hiddenLayer);
@@ -56,7 +61,10 @@ MLPNetwork::MLPNetwork(const NetworkInfo::Map& map, QObject* parent) :
 
     int outputCount = m_infoMap.value(NetworkInfo::Key::OutputNeuronCount).toInt();
     m_outputLayer = new MLPOutputLayer(outputCount, this);
+    m_outputLayer->setActivationFunction(MLPActivation::functionFromMap(m_infoMap));
+    m_outputLayer->setActivationPrecision(activationPrecision());
     m_outputLayer->setLearningRate(learningRate());
+    m_outputLayer->setOptimizer(optimizer());
     addLayer(m_outputLayer);
 
     lastLayer->connectTo(m_outputLayer);
@@ -83,7 +91,10 @@ MLPNetwork::MLPNetwork(const SavedNetwork& savedNetwork, QObject* parent) :
         auto* hiddenLayer = new MLPHiddenLayer(savedLayers.at(i), this);
 
         hiddenLayer->setInitialWeightFunction(weightFunction);
+        hiddenLayer->setActivationFunction(MLPActivation::functionFromMap(m_infoMap));
+        hiddenLayer->setActivationPrecision(activationPrecision());
         hiddenLayer->setLearningRate(learningRate());
+        hiddenLayer->setOptimizer(optimizer());
         addLayer(hiddenLayer);
 
         lastLayer->connectTo(hiddenLayer);
@@ -91,7 +102,10 @@ MLPNetwork::MLPNetwork(const SavedNetwork& savedNetwork, QObject* parent) :
     }
 
     m_outputLayer = new MLPOutputLayer(savedLayers.last(), this);
+    m_outputLayer->setActivationFunction(MLPActivation::functionFromMap(m_infoMap));
+    m_outputLayer->setActivationPrecision(activationPrecision());
     m_outputLayer->setLearningRate(learningRate());
+    m_outputLayer->setOptimizer(optimizer());
     addLayer(m_outputLayer);
 
     lastLayer->connectTo(m_outputLayer);
@@ -99,6 +113,9 @@ MLPNetwork::MLPNetwork(const SavedNetwork& savedNetwork, QObject* parent) :
 
 void MLPNetwork::init()
 {
+    if (m_infoMap.contains(NetworkInfo::Key::BatchSize))
+        m_batchSize = qMax(1, m_infoMap[NetworkInfo::Key::BatchSize].toInt());
+
     if (m_infoMap.contains(NetworkInfo::Key::ActivationFunction))
         setActivationFunction(MLPActivation::functionFromMap(m_infoMap));
     else
@@ -107,14 +124,17 @@ void MLPNetwork::init()
 
     connect(this, &Network::infoChanged, this, [this] {
         //
-        // Set the learning rate in all non-input layers
+        // Set the learning rate and the optimizer in all non-input layers
         //
+        QMutexLocker locker(&trainingMutex());
         auto rate = learningRate();
+        auto optimizer = this->optimizer();
         for (int i = 0; i < layerCount(); i++) {
             auto* layer = mlpLayer(i);
             if (layer->infoType() == NetworkLayerInfo::Type::Input)
                 continue;
             layer->setLearningRate(rate);
+            layer->setOptimizer(optimizer);
         }
     });
 }
@@ -130,29 +150,58 @@ NetworkInfo::Map MLPNetwork::createDefaultInfoMap() const
     return map;
 }
 
-QVector<double> MLPNetwork::compute(const QVector<double>& input) const
+void MLPNetwork::compute(const double* input, double* output, NetworkWorkspace& workspace) const
 {
-    QVector<double> vector = input;
-    for (int i = 1; i < layerCount(); i++)
-        vector = mlpLayer(i)->compute(vector);
+    const int last = layerCount() - 1;
+    const double* layerInput = input;
+    for (int i = 1; i <= last; i++) {
+        const auto* layer = mlpLayer(i);
+        double* layerOutput = (i == last)
+                ? output
+                : workspace.layerBuffer(i, layer->activations().size());
+
+        layer->computeInto(layerInput, layerOutput);
+        layerInput = layerOutput;
+    }
+}
 
-    return vector;
+void MLPNetwork::computeBatch(const double* inputs, int count, double* outputs,
+                              NetworkWorkspace& workspace) const
+{
+    const int last = layerCount() - 1;
+    const double* layerInputs = inputs;
+    for (int i = 1; i <= last; i++) {
+        const auto* layer = mlpLayer(i);
+        double* layerOutputs = (i == last)
+                ? outputs
+                : workspace.layerBuffer(i, count * layer->activations().size());
+
+        layer->computeBatchInto(layerInputs, count, layerOutputs);
+        layerInputs = layerOutputs;
+    }
 }
 
-void MLPNetwork::computeAndSet(const QVector<double>& input)
+void MLPNetwork::computeBatch(const float* inputs, int count, float* outputs,
+                              NetworkWorkspace& workspace) const
 {
-    QVector<double> vector = input;
+    const int last = layerCount() - 1;
+    const float* layerInputs = inputs;
+    for (int i = 1; i <= last; i++) {
+        const auto* layer = mlpLayer(i);
+        float* layerOutputs = (i == last)
+                ? outputs
+                : workspace.singleLayerBuffer(i, count * layer->activations().size());
+
+        layer->computeBatchInto(layerInputs, count, layerOutputs);
+        layerInputs = layerOutputs;
+    }
+}
 
-    // Compute and use the result as input for the next layer
+void MLPNetwork::computeAndSet(const QVector<double>& input)
+{
     m_inputLayer->setValues(input);
-    for (int i = 1; i < layerCount(); i++) {
-        auto* layer = mlpLayer(i);
-
-        layer->computeAndSet(vector);
-        if (layer->infoType() == NetworkLayerInfo::Type::Output)
-            break;
-        vector = layer->values(true);
-    }
+    for (int i = 1; i < layerCount(); i++)
+        mlpLayer(i)->forward();
 }
 
 MLPLayer* MLPNetwork::mlpLayer(int index) const
@@ -171,12 +220,72 @@ void MLPNetwork::train(const TrainingSample& sample)
 
     for (int i = layerCount() - 2; i > 0; i--)
         mlpLayer(i)->updateDelta();
+
+    if (m_batchSize <= 1) {
+        for (int i = layerCount() - 1; i > 0; i--)
+            mlpLayer(i)->updateWeights();
+        return;
+    }
+    //
+    // Mini-batch training, the weights are only updated once all samples of
+    // the batch have been seen
+    //
     for (int i = layerCount() - 1; i > 0; i--)
-        mlpLayer(i)->updateWeights();
+        mlpLayer(i)->accumulateBatch();
+    if (++m_batchSamples >= m_batchSize)
+        applyBatch();
+}
+
+void MLPNetwork::applyBatch()
+{
+    for (int i = layerCount() - 1; i > 0; i--)
+        mlpLayer(i)->applyBatch();
+
+    m_batchSamples = 0;
+}
+
+int MLPNetwork::batchSize() const
+{
+    return m_batchSize;
+}
+
+void MLPNetwork::setBatchSize(int batchSize)
+{
+    Q_ASSERT(batchSize > 0);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (m_batchSize != batchSize) {
+        m_batchSize = batchSize;
+        if (batchSize > 1)
+            m_infoMap[NetworkInfo::Key::BatchSize] = batchSize;
+        else
+            m_infoMap.remove(NetworkInfo::Key::BatchSize);
+        emit infoChanged();
+    }
+}
+
+void MLPNetwork::prepareTraining()
+{
+    for (int i = 1; i < layerCount(); i++) {
+        mlpLayer(i)->resetBatch();
+        mlpLayer(i)->resetOptimizer();
+    }
+    m_batchSamples = 0;
+}
+
+void MLPNetwork::finishTraining()
+{
+    //
+    // Do not lose the samples of an incomplete batch
+    //
+    applyBatch();
 }
 
 void MLPNetwork::setActivationFunction(MLPActivation::Function function)
 {
+    QMutexLocker locker(&trainingMutex());
+
     if (function != MLPActivation::functionFromMap(m_infoMap)) {
         for (int i = 1; i < layerCount(); i++)
             mlpLayer(i)->setActivationFunction(function);
@@ -186,6 +295,29 @@ void MLPNetwork::setActivationFunction(MLPActivation::Function function)
     }
 }
 
+MLPActivation::Precision MLPNetwork::activationPrecision() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::ActivationPrecision))
+        return MLPActivation::precisionFromMap(m_infoMap);
+
+    return MLPActivation::Precision::Exact;
+}
+
+void MLPNetwork::setActivationPrecision(MLPActivation::Precision precision)
+{
+    Q_ASSERT(precision != MLPActivation::Precision::Unknown);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (precision != activationPrecision()) {
+        for (int i = 1; i < layerCount(); i++)
+            mlpLayer(i)->setActivationPrecision(precision);
+
+        m_infoMap[NetworkInfo::Key::ActivationPrecision] = QVariant::fromValue(precision);
+        emit infoChanged();
+    }
+}
+
 void MLPNetwork::updateScenePosition()
 {
     auto rect = GraphicsUtilities::neuronRect(scene(), layerCount(), neuronMaxCount());
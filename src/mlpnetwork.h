@@ -37,7 +37,13 @@ public:
     explicit MLPNetwork(const NetworkInfo::Map& map, QObject* parent = nullptr);
     explicit MLPNetwork(const SavedNetwork& savedNetwork, QObject* parent = nullptr);
 
-    QVector<double> compute(const QVector<double>& input) const override;
+    using Network::compute;
+    using Network::computeBatch;
+    void compute(const double* input, double* output, NetworkWorkspace& workspace) const override;
+    void computeBatch(const double* inputs, int count, double* outputs,
+                      NetworkWorkspace& workspace) const override;
+    void computeBatch(const float* inputs, int count, float* outputs,
+                      NetworkWorkspace& workspace) const override;
     void computeAndSet(const QVector<double>& input) override;
     NetworkInfo::Map createDefaultInfoMap() const override;
 
@@ -45,10 +51,27 @@ public:
 
     void train(const TrainingSample& sample) override;
     void setActivationFunction(MLPActivation::Function function);
+    MLPActivation::Precision activationPrecision() const;
+    void setActivationPrecision(MLPActivation::Precision precision);
     void updateScenePosition() override;
 
+    int batchSize() const;
+    void setBatchSize(int batchSize);
+
+protected:
+    void prepareTraining() override;
+    void finishTraining() override;
+
 private:
     void init();
+    void applyBatch();
+
+    //
+    // Number of samples whose gradients are accumulated before the weights are
+    // updated, the weights are updated after every sample when this is 1
+    //
+    int m_batchSize = 1;
+    int m_batchSamples = 0;
 
     MLPInputLayer* m_inputLayer;
     MLPOutputLayer* m_outputLayer;
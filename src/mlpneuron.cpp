@@ -32,66 +32,11 @@ MLPNeuron::MLPNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent) :
 {
 }
 
-double MLPNeuron::compute(const QVector<double>& input)
-{
-    // Bias unit
-    double value = inConnection(0)->weight();
-
-    // Connections from the real neurons
-    for (int i = 1; i < inConnectionCount(); i++)
-        value += input[i - 1] * inConnection(i)->weight();
-
-    return MLPActivation::function(m_activationFunction, value);
-}
-
-void MLPNeuron::forward()
-{
-    double value = 0.0;
-    for (const auto* conn : inConnections())
-        value += conn->neuron1()->value() * conn->weight();
-
-    setValue(MLPActivation::function(m_activationFunction, value));
-}
-
-double MLPNeuron::delta() const
-{
-    return m_delta;
-}
-
 void MLPNeuron::setActivationFunction(MLPActivation::Function function)
 {
     m_activationFunction = function;
 }
 
-void MLPNeuron::setLearningRate(double learningRate)
-{
-    m_learningRate = learningRate;
-}
-
-void MLPNeuron::updateDelta()
-{
-    m_delta = 0.0;
-    const auto& connections = outConnections();
-    for (const auto* conn : connections) {
-        const auto* outNeuron = qobject_cast<MLPNeuron*>(conn->neuron2());
-        m_delta += conn->weight() * outNeuron->delta();
-    }
-    m_delta *= MLPActivationDerivative::function(m_activationFunction, value());
-}
-
-//
-// Update the weights of the neuron's input connections
-//
-void MLPNeuron::updateWeights()
-{
-    const auto& connections = inConnections();
-    for (auto* conn : connections) {
-        double weight = conn->weight() - m_learningRate * m_delta * conn->neuron1()->value();
-
-        conn->setWeight(weight);
-    }
-}
-
 void MLPNeuron::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
     QColor color;
@@ -34,19 +34,11 @@ public:
     explicit MLPNeuron(NetworkLayer* parent);
     explicit MLPNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent);
 
-    double compute(const QVector<double>& input);
-    double delta() const;
-    void forward();
     void setActivationFunction(MLPActivation::Function function);
-    void setLearningRate(double learningRate);
-    void updateDelta();
-    void updateWeights();
 
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
 
 protected:
-    double m_delta;
     QColor m_lastColor;
-    double m_learningRate = 1.0;
     MLPActivation::Function m_activationFunction = MLPActivation::Function::Sigmoid;
 };
@@ -19,6 +19,7 @@
  */
 #include "mlpoutputlayer.h"
 
+#include "mlpactivation.h"
 #include "mlpoutputneuron.h"
 
 MLPOutputLayer::MLPOutputLayer(int neurons, Network* parent) :
@@ -64,6 +65,10 @@ void MLPOutputLayer::updateDelta(const QVector<double>& target)
 {
     Q_ASSERT(target.size() == neuronCount());
 
-    for (int i = 0; i < neuronCount(); i++)
-        mlpOutputNeuron(i)->updateDelta(target.at(i));
+    m_deltas.resize(m_activations.size());
+    for (int i = 0; i < m_activations.size(); i++)
+        m_deltas[i] = m_activations.at(i) - target.at(i);
+
+    m_activationKernels->multiplyDerivative(m_activations.constData(), m_deltas.data(),
+                                            m_deltas.size());
 }
@@ -19,8 +19,6 @@
  */
 #include "mlpoutputneuron.h"
 
-#include "mlpactivation.h"
-
 MLPOutputNeuron::MLPOutputNeuron(NetworkLayer* parent) :
     MLPNeuron(parent)
 {
@@ -30,8 +28,3 @@ MLPOutputNeuron::MLPOutputNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer*
     MLPNeuron(savedNeuron, parent)
 {
 }
-
-void MLPOutputNeuron::updateDelta(double target)
-{
-    m_delta = (value() - target) * MLPActivationDerivative::function(m_activationFunction, value());
-}
@@ -29,6 +29,4 @@ class MLPOutputNeuron : public MLPNeuron
 public:
     explicit MLPOutputNeuron(NetworkLayer *parent);
     explicit MLPOutputNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent);
-
-    void updateDelta(double target);
 };
@@ -43,6 +43,9 @@ void MLPTrainingOptionsDialog::init()
 
     ui->editLearningRate->setValue(map[NetworkInfo::Key::LearningRate].toDouble());
 
+    ui->comboBoxOptimizer->addItems(NetworkInfo::optimizerStringList());
+    ui->comboBoxOptimizer->setCurrentIndex(NetworkInfo::optimizerToIndex(qobject_cast<MLPNetwork*>(m_network)->optimizer()));
+
     if (map.contains(NetworkInfo::Key::MaxEpochs)) {
         ui->checkBoxMaxEpochs->setChecked(true);
         ui->editMaxEpochs->setEnabled(true);
@@ -63,9 +66,25 @@ void MLPTrainingOptionsDialog::init()
     if (map.contains(NetworkInfo::Key::SampleSelectionOrder))
         ui->comboBoxSampleSelectionOrder->setCurrentIndex(NetworkInfo::sampleSelectionOrderIndexFromMap(map));
 
+    ui->comboBoxEvaluationMode->addItems(NetworkInfo::evaluationModeStringList());
+    ui->comboBoxEvaluationMode->setCurrentIndex(
+                NetworkInfo::evaluationModeToIndex(m_network->evaluationMode()));
+    ui->editEvaluationInterval->setValue(m_network->evaluationInterval());
+
+    ui->comboBoxEvaluationPrecision->addItems(NetworkInfo::evaluationPrecisionStringList());
+    ui->comboBoxEvaluationPrecision->setCurrentIndex(
+                NetworkInfo::evaluationPrecisionToIndex(m_network->evaluationPrecision()));
+
     ui->comboBoxActivationFunction->addItems(MLPActivation::functionStringList());
     if (map.contains(NetworkInfo::Key::ActivationFunction))
         ui->comboBoxActivationFunction->setCurrentIndex(MLPActivation::functionIndexFromMap(map));
+
+    ui->comboBoxActivationPrecision->addItems(MLPActivation::precisionStringList());
+    ui->comboBoxActivationPrecision->setCurrentIndex(
+                MLPActivation::precisionToIndex(qobject_cast<MLPNetwork*>(m_network)->activationPrecision()));
+
+    if (map.contains(NetworkInfo::Key::BatchSize))
+        ui->editBatchSize->setValue(map[NetworkInfo::Key::BatchSize].toInt());
 }
 
 void MLPTrainingOptionsDialog::accept()
@@ -83,10 +102,24 @@ void MLPTrainingOptionsDialog::accept()
                 NetworkInfo::sampleSelectionOrderFromIndex(
                     ui->comboBoxSampleSelectionOrder->currentIndex()));
 
+    m_network->setEvaluationMode(
+                NetworkInfo::evaluationModeFromIndex(
+                    ui->comboBoxEvaluationMode->currentIndex()));
+    m_network->setEvaluationInterval(ui->editEvaluationInterval->value());
+    m_network->setEvaluationPrecision(
+                NetworkInfo::evaluationPrecisionFromIndex(
+                    ui->comboBoxEvaluationPrecision->currentIndex()));
+
     auto* mlpNetwork = qobject_cast<MLPNetwork*>(m_network);
     mlpNetwork->setActivationFunction(
                 MLPActivation::functionFromIndex(
                     ui->comboBoxActivationFunction->currentIndex()));
+    mlpNetwork->setActivationPrecision(
+                MLPActivation::precisionFromIndex(
+                    ui->comboBoxActivationPrecision->currentIndex()));
+    mlpNetwork->setBatchSize(ui->editBatchSize->value());
+    mlpNetwork->setOptimizer(
+                NetworkInfo::optimizerFromIndex(ui->comboBoxOptimizer->currentIndex()));
 
     if (ui->checkBoxStopError->isChecked())
         m_network->setStopError(ui->editStopError->value());
@@ -105,3 +138,12 @@ void MLPTrainingOptionsDialog::on_checkBoxStopError_clicked(bool checked)
 {
     ui->editStopError->setEnabled(checked);
 }
+
+void MLPTrainingOptionsDialog::on_comboBoxEvaluationMode_currentIndexChanged(int index)
+{
+    //
+    // The interval is only used by the interval evaluation mode
+    //
+    ui->editEvaluationInterval->setEnabled(
+                NetworkInfo::evaluationModeFromIndex(index) == NetworkInfo::EvaluationMode::Interval);
+}
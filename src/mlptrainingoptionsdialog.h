@@ -41,6 +41,7 @@ public:
 private slots:
     void on_checkBoxMaxEpochs_clicked(bool checked);
     void on_checkBoxStopError_clicked(bool checked);
+    void on_comboBoxEvaluationMode_currentIndexChanged(int index);
 
 private:
     void init();
@@ -19,7 +19,13 @@
  */
 #include "network.h"
 
+#include <algorithm>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QTimer>
+
 #include "networkdefaults.h"
+#include "networktrainingthread.h"
 
 Network::Network(QObject* parent) :
     Network(NetworkInfo::Map(), parent)
@@ -31,7 +37,7 @@ Network::Network(const NetworkInfo::Map& map, QObject* parent) :
     m_infoMap(map),
     m_generator(std::random_device{}()),
     m_trainingTableModel(new TrainingTableModel(this)),
-    m_trainingTimer(new QTimer(this))
+    m_trainingThread(new NetworkTrainingThread(this))
 {
     setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 
@@ -39,13 +45,21 @@ Network::Network(const NetworkInfo::Map& map, QObject* parent) :
     initTrainingOptions();
 }
 
-const TrainingSample& Network::nextSample()
+Network::~Network()
+{
+    //
+    // Make sure the thread is finished before the layers are destroyed
+    //
+    delete m_trainingThread;
+}
+
+const TrainingSample& Network::nextSample(int* index)
 {
     switch (m_sampleSelectionOrder) {
         case SampleSelectionOrder::InOrder:
-            return m_trainingTableModel->currentSample();
+            return m_trainingTableModel->currentSample(true, index);
         case SampleSelectionOrder::Random:
-            return m_trainingTableModel->randomSample();
+            return m_trainingTableModel->randomSample(index);
         default:
             Q_UNREACHABLE();
             break;
@@ -65,45 +79,232 @@ void Network::init()
             m_infoMap.insert(i.key(), i.value());
     }
 
-    connect(m_trainingTimer, &QTimer::timeout, this, [this] {
-        if (m_trainingTimer->isSingleShot()) {
-            Q_ASSERT(m_trainingSampleDelay > 0);
-            //
-            // Readjust the timer to the real interval after the first sample
-            //
-            m_trainingTimer->setInterval(m_trainingSampleDelay);
-            m_trainingTimer->setSingleShot(false);
-            if (!m_trainingPrepared) {
-                prepareTraining();
-                m_trainingPrepared = true;
-                // The preparation function might have stopped or
-                // paused the training
-                if (!isTraining())
-                    return;
-            }
-            m_trainingTimer->start();
-        }
-        const auto& sample = nextSample();
-        train(sample);
+    //
+    // Results of the training thread are only accepted from the current generation,
+    // anything else was published before the training was paused or stopped
+    //
+    connect(m_trainingThread, &NetworkTrainingThread::snapshotReady, this,
+            [this](int generation, const NetworkSnapshot& snapshot) {
+        if (generation == m_trainingGeneration)
+            applySnapshot(snapshot);
+        m_trainingThread->snapshotConsumed();
+    });
+    connect(m_trainingThread, &NetworkTrainingThread::trainingPaused, this,
+            [this](int generation) {
+        if (generation == m_trainingGeneration)
+            pauseTraining();
+    });
+    connect(m_trainingThread, &NetworkTrainingThread::trainingStopped, this,
+            [this](int generation, StopTrainingReason reason) {
+        if (generation == m_trainingGeneration)
+            stopTraining(reason);
+    });
+}
+
+//
+// Train up to the given number of samples, this is called from the training thread.
+//
+// The number of samples actually trained is stored in 'trained', fewer samples are
+// trained when the training should be paused or stopped. The time spent training
+// them is stored in 'elapsed' in nanoseconds, it does not include the time spent
+// waiting for the training mutex or preparing the training.
+//
+Network::TrainingStepResult Network::trainNextSamples(int generation, int count, int* trained,
+                                                      qint64* elapsed, StopTrainingReason* reason)
+{
+    QMutexLocker locker(&m_trainingMutex);
 
-        m_trainingEpochs++;
-        emit trainingSampleDone(sample);
-        emit trainingStateChanged();
+    *trained = 0;
+    *elapsed = 0;
+    //
+    // The training might have been paused or stopped while waiting for the lock
+    //
+    if (!m_trainingThread->isCurrentGeneration(generation))
+        return TrainingStepResult::Suspended;
+
+    if (!m_trainingPrepared) {
+        m_preparationGeneration.storeRelease(generation);
+        m_precomputationInvalidated.storeRelease(0);
+        locker.unlock();
+        bool precomputed = precomputeTraining();
+        locker.relock();
+        //
+        // The training might have been paused or stopped during the computation,
+        // it will be prepared again when it's resumed. When the precomputation
+        // has only been invalidated, it is repeated right away.
+        //
+        if (!precomputed
+                || m_precomputationInvalidated.loadAcquire() != 0
+                || !m_trainingThread->isCurrentGeneration(generation))
+            return TrainingStepResult::Suspended;
+
+        m_trainingPauseRequested = false;
+        m_trainingStopRequested = false;
+        prepareTraining();
+        m_trainingPrepared = true;
+        // The preparation function might have requested a stop or a pause
+        if (m_trainingStopRequested) {
+            *reason = m_trainingStopReason;
+            return TrainingStepResult::Stop;
+        }
+        if (m_trainingPauseRequested)
+            return TrainingStepResult::Pause;
+    }
+    auto result = TrainingStepResult::Continue;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count && result == TrainingStepResult::Continue; i++) {
+        int sampleIndex;
+        const auto& sample = nextSample(&sampleIndex);
+        train(sample, sampleIndex);
+        sampleTrained(sample);
+        m_lastTrainingSample = sample;
+        (*trained)++;
+
+        int epochs = m_trainingEpochs.fetchAndAddOrdered(1) + 1;
         //
         // The training sample is done at this point, verify whether we
         // should stop the training
         //
-        if (m_maxTrainingEpochs == m_trainingEpochs)
-            stopTraining(StopTrainingReason::MaxEpochsReached);
-        else {
-            StopTrainingReason reason;
-            if (isStopConditionReached(&reason))
-                stopTraining(reason);
+        if (m_maxTrainingEpochs > 0 && epochs >= m_maxTrainingEpochs) {
+            *reason = StopTrainingReason::MaxEpochsReached;
+            result = TrainingStepResult::Stop;
+        } else if (isStopConditionReached(reason)) {
+            result = TrainingStepResult::Stop;
+        } else if (m_pauseAfterSample) {
+            // Pause training if requested
+            result = TrainingStepResult::Pause;
         }
-        // Pause training if requested
-        if (m_training && m_pauseAfterSample)
-            pauseTraining();
-    });
+    }
+    *elapsed = timer.nsecsElapsed();
+    return result;
+}
+
+//
+// Copy the current values and weights of all layers, this is called from the
+// training thread
+//
+NetworkSnapshot Network::createSnapshot() const
+{
+    QMutexLocker locker(&m_trainingMutex);
+
+    NetworkSnapshot snapshot;
+    snapshot.sample = m_lastTrainingSample;
+    for (const auto* layer : m_layers) {
+        snapshot.values.append(layer->activations());
+        snapshot.weights.append(layer->inWeights());
+    }
+    return snapshot;
+}
+
+//
+// Display a snapshot published by the training thread
+//
+void Network::applySnapshot(const NetworkSnapshot& snapshot)
+{
+    Q_ASSERT(snapshot.values.size() == m_layers.size());
+
+    for (int i = 0; i < m_layers.size(); i++) {
+        auto* layer = m_layers.at(i);
+
+        layer->applyNeuronValues(snapshot.values.at(i));
+        if (!snapshot.weights.at(i).isEmpty())
+            layer->applyInConnectionWeights(snapshot.weights.at(i));
+    }
+    //
+    // A single notification stands for all samples trained since the previous
+    // snapshot
+    //
+    flushWeightUpdates();
+    if (snapshot.sample.isValid())
+        emit trainingSampleDone(snapshot.sample);
+    emit trainingStateChanged();
+}
+
+//
+// Display the current state of all layers once the training thread is suspended
+//
+void Network::syncTrainingState()
+{
+    QMutexLocker locker(&m_trainingMutex);
+
+    for (auto* layer : qAsConst(m_layers)) {
+        layer->syncNeuronValues();
+        layer->syncInConnectionWeights();
+    }
+    flushWeightUpdates();
+}
+
+//
+// Remember that the incoming weights of the layer have changed, all changes made
+// until the next event loop iteration are announced by a single weightsUpdated()
+// signal
+//
+void Network::markWeightsChanged(int layerIndex)
+{
+    if (m_changedWeightLayers.size() != m_layers.size())
+        m_changedWeightLayers.resize(m_layers.size());
+
+    m_changedWeightLayers.setBit(layerIndex);
+    if (!m_weightUpdatePending) {
+        m_weightUpdatePending = true;
+        QTimer::singleShot(0, this, &Network::flushWeightUpdates);
+    }
+}
+
+//
+// Announce the weight changes collected since the last call
+//
+void Network::flushWeightUpdates()
+{
+    m_weightUpdatePending = false;
+    if (m_changedWeightLayers.count(true) == 0)
+        return;
+
+    QBitArray layers = m_changedWeightLayers;
+    m_changedWeightLayers.fill(false);
+
+    emit weightsUpdated(layers);
+}
+
+QMutex& Network::trainingMutex() const
+{
+    return m_trainingMutex;
+}
+
+//
+// Return true if the training being prepared has been paused or stopped, or if the
+// precomputation has been invalidated, this may be called from precomputeTraining()
+// in any thread
+//
+bool Network::isTrainingCancelled() const
+{
+    return m_precomputationInvalidated.loadAcquire() != 0
+            || !m_trainingThread->isCurrentGeneration(m_preparationGeneration.loadAcquire());
+}
+
+void Network::invalidatePrecomputation()
+{
+    m_precomputationInvalidated.storeRelease(1);
+}
+
+//
+// Pause the training once the preparation is done, this may only be called from
+// prepareTraining()
+//
+void Network::requestTrainingPause()
+{
+    m_trainingPauseRequested = true;
+}
+
+//
+// Stop the training once the preparation is done for the given reason, this may
+// only be called from prepareTraining()
+//
+void Network::requestTrainingStop(StopTrainingReason reason)
+{
+    m_trainingStopRequested = true;
+    m_trainingStopReason = reason;
 }
 
 //
@@ -112,6 +313,15 @@ void Network::init()
 //
 void Network::initTrainingOptions()
 {
+    if (m_infoMap.contains(NetworkInfo::Key::EvaluationInterval))
+        m_evaluationInterval = m_infoMap[NetworkInfo::Key::EvaluationInterval].toInt();
+
+    if (m_infoMap.contains(NetworkInfo::Key::EvaluationMode))
+        m_evaluationMode = evaluationModeFromMap(m_infoMap);
+
+    if (m_infoMap.contains(NetworkInfo::Key::EvaluationPrecision))
+        m_evaluationPrecision = evaluationPrecisionFromMap(m_infoMap);
+
     if (m_infoMap.contains(NetworkInfo::Key::LearningRate))
         m_learningRate = m_infoMap[NetworkInfo::Key::LearningRate].toDouble();
 
@@ -196,10 +406,93 @@ void Network::setName(QString name)
     }
 }
 
+//
+// Compute the output of the network for the given input, this allocates the
+// result and the workspace, use the other overloads to compute many samples
+//
 QVector<double> Network::compute(const QVector<double>& input) const
+{
+    Q_ASSERT(input.size() == inputLayer()->activations().size());
+
+    QVector<double> output(outputLayer()->activations().size());
+
+    auto workspace = createWorkspace();
+    compute(input.constData(), output.data(), workspace);
+    return output;
+}
+
+//
+// Compute the output of the network using the buffers in the workspace, the
+// output must have room for the values of all non-bias output neurons
+//
+void Network::compute(const double* input, double* output, NetworkWorkspace& workspace) const
 {
     Q_UNUSED(input);
-    return QVector<double>();
+    Q_UNUSED(output);
+    Q_UNUSED(workspace);
+}
+
+//
+// Compute the outputs of a batch of samples.
+//
+// The inputs are stored as a row-major matrix with one row per sample and one
+// column per non-bias input neuron, the outputs are stored the same way. This
+// implementation computes the samples one by one, networks reimplement it to
+// compute whole layers at once.
+//
+void Network::computeBatch(const double* inputs, int count, double* outputs,
+                           NetworkWorkspace& workspace) const
+{
+    const int inputCount = inputLayer()->activations().size();
+    const int outputCount = outputLayer()->activations().size();
+
+    for (int i = 0; i < count; i++)
+        compute(inputs + i * inputCount, outputs + i * outputCount, workspace);
+}
+
+QVector<double> Network::computeBatch(const QVector<double>& inputs) const
+{
+    const int inputCount = inputLayer()->activations().size();
+    const int outputCount = outputLayer()->activations().size();
+    Q_ASSERT(inputCount > 0 && inputs.size() % inputCount == 0);
+
+    const int count = inputs.size() / inputCount;
+    QVector<double> outputs(count * outputCount);
+
+    auto workspace = createWorkspace();
+    computeBatch(inputs.constData(), count, outputs.data(), workspace);
+    return outputs;
+}
+
+//
+// Compute the outputs of a batch of samples in single precision.
+//
+// The layers use the single-precision copies of their weights, which must be
+// refreshed by updateSingleWeights() after the weights change. This implementation
+// computes the samples one by one in double precision.
+//
+void Network::computeBatch(const float* inputs, int count, float* outputs,
+                           NetworkWorkspace& workspace) const
+{
+    const int inputCount = inputLayer()->activations().size();
+    const int outputCount = outputLayer()->activations().size();
+
+    QVector<double> input(inputCount);
+    QVector<double> output(outputCount);
+    for (int i = 0; i < count; i++) {
+        std::copy(inputs + i * inputCount, inputs + (i + 1) * inputCount, input.begin());
+        compute(input.constData(), output.data(), workspace);
+        std::copy(output.constBegin(), output.constEnd(), outputs + i * outputCount);
+    }
+}
+
+//
+// Copy the weights of all layers to their single-precision weight matrices
+//
+void Network::updateSingleWeights()
+{
+    for (auto* layer : qAsConst(m_layers))
+        layer->updateSingleInWeights();
 }
 
 void Network::computeAndSet(const QVector<double>& input)
@@ -207,6 +500,19 @@ void Network::computeAndSet(const QVector<double>& input)
     Q_UNUSED(input);
 }
 
+NetworkWorkspace Network::createWorkspace() const
+{
+    int width = 0;
+    for (const auto* layer : m_layers)
+        width = qMax(width, layer->activations().size());
+
+    NetworkWorkspace workspace;
+    workspace.buffers[0].resize(width);
+    workspace.buffers[1].resize(width);
+
+    return workspace;
+}
+
 //
 // Create a function which returns an initial connection weight
 //
@@ -259,6 +565,17 @@ NetworkInfo::Map Network::createDefaultInfoMap() const
     return map;
 }
 
+//
+// Train with the sample at the given index of the training set, networks which
+// keep data for every sample can use the index to find it
+//
+void Network::train(const TrainingSample& sample, int sampleIndex)
+{
+    Q_UNUSED(sampleIndex);
+
+    train(sample);
+}
+
 void Network::prepareTraining()
 {
 }
@@ -272,6 +589,8 @@ void Network::cleanupTraining()
 //
 void Network::setConnectionWeights(double min, double max, const QVector<int>& layers, bool updateNetworkInfo)
 {
+    QMutexLocker locker(&m_trainingMutex);
+
     std::uniform_real_distribution<double> dist(min, max);
     std::function<double()> rnd = std::bind(dist, std::ref(m_generator));
 
@@ -293,6 +612,8 @@ void Network::setConnectionWeights(double min, double max, const QVector<int>& l
 //
 void Network::setConnectionWeights(double value, const QVector<int>& layers, bool updateNetworkInfo)
 {
+    QMutexLocker locker(&m_trainingMutex);
+
     for (int i = 0; i < m_layers.size(); i++) {
         if (layers.isEmpty() || layers.contains(i))
             m_layers[i]->setOutConnectionWeights(value);
@@ -358,6 +679,10 @@ void Network::addLayer(NetworkLayer* layer)
             [this, index](int neuronIndex) {
         emit neuronWeightChanged(index, neuronIndex);
     });
+    connect(layer, &NetworkLayer::inWeightsChanged, this,
+            [this, index] {
+        markWeightsChanged(index);
+    });
     connect(layer, &NetworkLayer::neuronStatusMessage, this,
             [this, index](int neuronIndex, const QString& message) {
         emit neuronStatusMessage(index, neuronIndex, message);
@@ -416,8 +741,22 @@ void Network::setTrainingSampleDelay(int delay)
     Q_ASSERT(delay > 0);
 
     m_trainingSampleDelay = delay;
-    if (m_trainingTimer->isActive())
-        m_trainingTimer->setInterval(delay);
+    m_trainingThread->setSampleDelay(delay);
+}
+
+bool Network::isTurboTraining() const
+{
+    return m_turboTraining;
+}
+
+//
+// In the turbo mode the sample delay is ignored and samples are trained in batches
+// which fit into the time of a single display update
+//
+void Network::setTurboTraining(bool enabled)
+{
+    m_turboTraining = enabled;
+    m_trainingThread->setTurbo(enabled);
 }
 
 void Network::startTraining()
@@ -426,17 +765,21 @@ void Network::startTraining()
     if (m_trainingPaused)
         m_trainingPaused = false;
     else {
-        m_trainingEpochs = 0;
+        QMutexLocker locker(&m_trainingMutex);
+
+        m_trainingEpochs.storeRelease(0);
         m_trainingPrepared = false;
+        m_lastTrainingSample = TrainingSample();
     }
     //
-    // Initially set the timer to single-shot with 0 interval to make
-    // it fire as soon as possible to process the first sample, after
-    // the first sample it will be readjusted to the real interval.
+    // The thread trains the first sample as soon as possible, after
+    // that it waits for the sample delay between samples
     //
-    m_trainingTimer->setInterval(0);
-    m_trainingTimer->setSingleShot(true);
-    m_trainingTimer->start();
+    if (!m_trainingThread->isRunning()) {
+        m_trainingThread->setSampleDelay(m_trainingSampleDelay);
+        m_trainingThread->start();
+    }
+    m_trainingGeneration = m_trainingThread->resumeTraining();
     m_training = true;
 
     emit trainingStarted(paused);
@@ -450,9 +793,15 @@ void Network::stopTraining()
 
 void Network::stopTraining(StopTrainingReason reason)
 {
-    m_trainingTimer->stop();
+    m_trainingThread->suspendTraining();
+    m_trainingGeneration = 0;
     m_training = false;
     m_trainingPaused = false;
+    {
+        QMutexLocker locker(&m_trainingMutex);
+        finishTraining();
+    }
+    syncTrainingState();
     emit trainingStopped(reason);
     emit trainingStateChanged();
     cleanupTraining();
@@ -460,9 +809,11 @@ void Network::stopTraining(StopTrainingReason reason)
 
 void Network::pauseTraining()
 {
-    m_trainingTimer->stop();
+    m_trainingThread->suspendTraining();
+    m_trainingGeneration = 0;
     m_training = false;
     m_trainingPaused = true;
+    syncTrainingState();
     emit trainingPaused();
     emit trainingStateChanged();
 }
@@ -491,6 +842,8 @@ void Network::setLearningRate(double learningRate)
 {
     Q_ASSERT((learningRate > 0.0 && learningRate < 1.0) || qFuzzyCompare(learningRate, 1.0));
 
+    QMutexLocker locker(&m_trainingMutex);
+
     if (!qFuzzyCompare(learningRate, m_learningRate)) {
         m_learningRate = learningRate;
         m_infoMap[NetworkInfo::Key::LearningRate] = learningRate;
@@ -500,7 +853,7 @@ void Network::setLearningRate(double learningRate)
 
 int Network::trainingEpochs() const
 {
-    return m_trainingEpochs;
+    return m_trainingEpochs.loadAcquire();
 }
 
 int Network::maxTrainingEpochs() const
@@ -512,6 +865,8 @@ void Network::setMaxTrainingEpochs(int maxEpochs)
 {
     Q_ASSERT(maxEpochs >= 0);
 
+    QMutexLocker locker(&m_trainingMutex);
+
     if (m_maxTrainingEpochs != maxEpochs) {
         m_maxTrainingEpochs = maxEpochs;
         if (maxEpochs > 0)
@@ -539,6 +894,8 @@ bool Network::pauseAfterSample() const
 
 void Network::setPauseAfterSample(bool pauseAfterSample)
 {
+    QMutexLocker locker(&m_trainingMutex);
+
     if (m_pauseAfterSample != pauseAfterSample) {
         m_pauseAfterSample = pauseAfterSample;
         m_infoMap[NetworkInfo::Key::PauseAfterSample] = pauseAfterSample;
@@ -553,6 +910,8 @@ NetworkInfo::SampleSelectionOrder Network::sampleSelectionOrder() const
 
 void Network::setSampleSelectionOrder(NetworkInfo::SampleSelectionOrder sso)
 {
+    QMutexLocker locker(&m_trainingMutex);
+
     if (m_sampleSelectionOrder != sso) {
         m_sampleSelectionOrder = sso;
         m_infoMap[NetworkInfo::Key::SampleSelectionOrder] = QVariant::fromValue(sso);
@@ -560,10 +919,64 @@ void Network::setSampleSelectionOrder(NetworkInfo::SampleSelectionOrder sso)
     }
 }
 
+NetworkInfo::EvaluationMode Network::evaluationMode() const
+{
+    return m_evaluationMode;
+}
+
+void Network::setEvaluationMode(NetworkInfo::EvaluationMode mode)
+{
+    QMutexLocker locker(&m_trainingMutex);
+
+    if (m_evaluationMode != mode) {
+        m_evaluationMode = mode;
+        m_infoMap[NetworkInfo::Key::EvaluationMode] = QVariant::fromValue(mode);
+        emit infoChanged();
+    }
+}
+
+int Network::evaluationInterval() const
+{
+    return m_evaluationInterval;
+}
+
+void Network::setEvaluationInterval(int interval)
+{
+    Q_ASSERT(interval > 0);
+
+    QMutexLocker locker(&m_trainingMutex);
+
+    if (m_evaluationInterval != interval) {
+        m_evaluationInterval = interval;
+        m_infoMap[NetworkInfo::Key::EvaluationInterval] = interval;
+        emit infoChanged();
+    }
+}
+
+NetworkInfo::EvaluationPrecision Network::evaluationPrecision() const
+{
+    return m_evaluationPrecision;
+}
+
+void Network::setEvaluationPrecision(NetworkInfo::EvaluationPrecision precision)
+{
+    Q_ASSERT(precision != NetworkInfo::EvaluationPrecision::Unknown);
+
+    QMutexLocker locker(&m_trainingMutex);
+
+    if (m_evaluationPrecision != precision) {
+        m_evaluationPrecision = precision;
+        m_infoMap[NetworkInfo::Key::EvaluationPrecision] = QVariant::fromValue(precision);
+        emit infoChanged();
+    }
+}
+
 void Network::setStopPercentage(double percentage)
 {
     Q_ASSERT(percentage > 0 || qFuzzyIsNull(percentage));
 
+    QMutexLocker locker(&m_trainingMutex);
+
     if (!qFuzzyCompare(percentage, m_stopPercentage)) {
         m_stopPercentage = percentage;
         if (percentage > 0)
@@ -578,6 +991,8 @@ void Network::setStopSamples(int samples)
 {
     Q_ASSERT(samples >= 0);
 
+    QMutexLocker locker(&m_trainingMutex);
+
     if (m_stopSamples != samples) {
         m_stopSamples = samples;
         if (samples > 0)
@@ -590,6 +1005,8 @@ void Network::setStopSamples(int samples)
 
 void Network::setStopError(double error)
 {
+    QMutexLocker locker(&m_trainingMutex);
+
     if (!qFuzzyCompare(error, m_stopError)) {
         m_stopError = error;
         if (!qFuzzyIsNull(error))
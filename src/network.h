@@ -23,15 +23,20 @@
 
 #include <functional>
 #include <random>
+#include <QAtomicInt>
+#include <QBitArray>
 #include <QGraphicsItemGroup>
+#include <QMutex>
 #include <QString>
-#include <QTimer>
 #include <QVector>
 
 class Network;
+class NetworkTrainingThread;
 
 #include "networkinfo.h"
 #include "networklayer.h"
+#include "networksnapshot.h"
+#include "networkworkspace.h"
 #include "trainingtablemodel.h"
 #include "trainingsample.h"
 
@@ -44,13 +49,14 @@ public:
         ErrorReached,
         PercentageReached,
         SamplesReached,
-        MaxEpochsReached
+        MaxEpochsReached,
+        WeightsSolved
     };
     Q_ENUM(StopTrainingReason)
 
     explicit Network(QObject* parent = nullptr);
     explicit Network(const NetworkInfo::Map& map, QObject* parent = nullptr);
-    virtual ~Network() {}
+    virtual ~Network();
 
     NetworkLayer *inputLayer() const;
     int inputLayerIndex() const;
@@ -61,9 +67,18 @@ public:
     QString name() const;
     void setName(QString name);
 
-    virtual QVector<double> compute(const QVector<double>& input) const;
+    QVector<double> compute(const QVector<double>& input) const;
+    virtual void compute(const double* input, double* output, NetworkWorkspace& workspace) const;
+    virtual void computeBatch(const double* inputs, int count, double* outputs,
+                              NetworkWorkspace& workspace) const;
+    QVector<double> computeBatch(const QVector<double>& inputs) const;
+    virtual void computeBatch(const float* inputs, int count, float* outputs,
+                              NetworkWorkspace& workspace) const;
+    void updateSingleWeights();
     virtual void computeAndSet(const QVector<double>& input);
 
+    NetworkWorkspace createWorkspace() const;
+
     //
     // When reimplmenting call this method to retrieve the general defaults
     //
@@ -83,6 +98,8 @@ public:
     void stopTraining();
     void pauseTraining();
     void setTrainingSampleDelay(int delay);
+    bool isTurboTraining() const;
+    void setTurboTraining(bool enabled);
 
     //
     // Training information and options
@@ -91,6 +108,14 @@ public:
     bool isTrainingPaused() const;
     int trainingEpochs() const;
 
+    //
+    // Training runs in a separate thread, which holds this mutex while it
+    // trains a sample. Lock it to read the state of the layers from the GUI
+    // or to change anything the training thread uses while the network is
+    // being trained.
+    //
+    QMutex& trainingMutex() const;
+
     double learningRate() const;
     void setLearningRate(double learningRate);
 
@@ -112,7 +137,17 @@ public:
     NetworkInfo::SampleSelectionOrder sampleSelectionOrder() const;
     void setSampleSelectionOrder(NetworkInfo::SampleSelectionOrder sso);
 
+    NetworkInfo::EvaluationMode evaluationMode() const;
+    void setEvaluationMode(NetworkInfo::EvaluationMode mode);
+
+    int evaluationInterval() const;
+    void setEvaluationInterval(int interval);
+
+    NetworkInfo::EvaluationPrecision evaluationPrecision() const;
+    void setEvaluationPrecision(NetworkInfo::EvaluationPrecision precision);
+
     virtual void train(const TrainingSample& sample) = 0;
+    virtual void train(const TrainingSample& sample, int sampleIndex);
     virtual void updateScenePosition() = 0;
 
     void addLayer(NetworkLayer* layer);
@@ -136,6 +171,11 @@ signals:
     void neuronNameChanged(int layerIndex, int neuronIndex);
     void neuronValueChanged(int layerIndex, int neuronIndex);
     void neuronWeightChanged(int layerIndex, int neuronIndex);
+    //
+    // Emitted at most once per displayed training step or event loop iteration,
+    // the bits mark the layers whose incoming weights have changed
+    //
+    void weightsUpdated(const QBitArray& layers);
     void neuronStatusMessage(int layerIndex, int index, const QString& message);
     void statusMessage(const QString& message);
     void trainingStarted(bool resumed);
@@ -159,21 +199,72 @@ protected:
         return false;
     }
 
+    //
+    // Called from the training thread right after a sample is trained and before
+    // the stop conditions are verified
+    //
+    virtual void sampleTrained(const TrainingSample& sample) {
+        Q_UNUSED(sample);
+    }
+
+    //
+    // Called from the training thread before prepareTraining() without holding
+    // the training mutex, so that lengthy computations do not block the GUI. The
+    // state of the layers must not be changed here and false should be returned
+    // as soon as isTrainingCancelled() returns true.
+    //
+    virtual bool precomputeTraining() {
+        return true;
+    }
+    bool isTrainingCancelled() const;
+    //
+    // Discard the result of precomputeTraining() because its input has changed,
+    // this must be called with the training mutex held
+    //
+    void invalidatePrecomputation();
+
     virtual void prepareTraining();
+    //
+    // Called with the training mutex held when the training is stopped, after the
+    // training thread is suspended and before the state of the layers is shown
+    //
+    virtual void finishTraining() {}
     virtual void cleanupTraining();
 
+    void requestTrainingPause();
+    void requestTrainingStop(StopTrainingReason reason);
+
     NetworkInfo::Map m_infoMap;
 
 private:
+    friend class NetworkTrainingThread;
+
+    enum class TrainingStepResult {
+        Continue,
+        Pause,
+        Stop,
+        Suspended
+    };
+
     void init();
     void initTrainingOptions();
-    const TrainingSample& nextSample();
+    const TrainingSample& nextSample(int* index);
     void stopTraining(StopTrainingReason reason);
+    TrainingStepResult trainNextSamples(int generation, int count, int* trained,
+                                        qint64* elapsed, StopTrainingReason* reason);
+    NetworkSnapshot createSnapshot() const;
+    void applySnapshot(const NetworkSnapshot& snapshot);
+    void syncTrainingState();
+    void markWeightsChanged(int layerIndex);
+    void flushWeightUpdates();
 
     std::mt19937 m_generator;
     QVector<NetworkLayer*> m_layers;
     TrainingTableModel* m_trainingTableModel;
-    QTimer* m_trainingTimer;
+    NetworkTrainingThread* m_trainingThread;
+    mutable QMutex m_trainingMutex { QMutex::Recursive };
+    QBitArray m_changedWeightLayers;
+    bool m_weightUpdatePending = false;
 
     //
     // Training information
@@ -181,8 +272,16 @@ private:
     bool m_training = false;
     bool m_trainingPaused = false;
     bool m_trainingPrepared = false;
-    int m_trainingEpochs = 0;
+    bool m_trainingPauseRequested = false;
+    bool m_trainingStopRequested = false;
+    StopTrainingReason m_trainingStopReason = StopTrainingReason::UserRequested;
+    int m_trainingGeneration = 0;
+    QAtomicInt m_preparationGeneration;
+    QAtomicInt m_precomputationInvalidated;
+    QAtomicInt m_trainingEpochs;
     int m_trainingSampleDelay = 1000;
+    bool m_turboTraining = false;
+    TrainingSample m_lastTrainingSample;
 
     //
     // Training options that have their default values set in the default map
@@ -201,4 +300,7 @@ private:
     double m_stopPercentage = 0.0;
     double m_stopError = 0.0;
     bool m_pauseAfterSample = false;
+    NetworkInfo::EvaluationMode m_evaluationMode = NetworkInfo::EvaluationMode::EverySample;
+    int m_evaluationInterval = 100;
+    NetworkInfo::EvaluationPrecision m_evaluationPrecision = NetworkInfo::EvaluationPrecision::Double;
 };
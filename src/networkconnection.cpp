@@ -96,10 +96,53 @@ double NetworkConnection::oldWeight() const
 //
 // Change the connection weight.
 //
+// The weight is also written to the weight matrix of the layer if the connection
+// is bound to it.
+//
 // Set adjustPenThickness to false if the weight change is going to be followed by a
 // weight range adjustment.
 //
 void NetworkConnection::setWeight(double weight, bool adjustPenThickness)
+{
+    if (m_weightMatrix != nullptr)
+        m_weightMatrix->setConnectionWeight(m_weightRow, m_weightColumn, weight);
+
+    updateWeight(weight, adjustPenThickness);
+}
+
+//
+// Bind the connection to a weight stored in the weight matrix of a layer.
+//
+// The matrix is the authoritative copy of the weight, the connection only keeps
+// the last displayed value, which is refreshed by syncWeight().
+//
+void NetworkConnection::setWeightSource(NetworkWeightMatrix* matrix, int row, int column)
+{
+    m_weightMatrix = matrix;
+    m_weightRow = row;
+    m_weightColumn = column;
+}
+
+//
+// Refresh the displayed weight from the given weight matrix, which is either the
+// matrix the connection is bound to or its copy.
+//
+// When 'notify' is false the weightChanged() signal is not emitted, the caller
+// is then responsible for announcing the change. Returns true if the weight has
+// changed.
+//
+bool NetworkConnection::syncWeight(const NetworkWeightMatrix& matrix, bool adjustPenThickness,
+                                   bool notify)
+{
+    if (m_weightMatrix == nullptr)
+        return false;
+
+    return updateWeight(matrix.connectionWeight(m_weightRow, m_weightColumn),
+                        adjustPenThickness,
+                        notify);
+}
+
+bool NetworkConnection::updateWeight(double weight, bool adjustPenThickness, bool notify)
 {
     if (!qFuzzyCompare(weight, m_weight)) {
         m_oldWeight = m_weight;
@@ -111,15 +154,21 @@ void NetworkConnection::setWeight(double weight, bool adjustPenThickness)
         m_minWeight = qMin(m_minWeight, weight);
         m_maxWeight = qMax(m_maxWeight, weight);
 
-        emit weightChanged(m_weight, m_oldWeight);
+        if (notify)
+            emit weightChanged(m_weight, m_oldWeight);
 
         if (adjustPenThickness && m_showValue)
             updatePenThickness();
+        return true;
     }
+    return false;
 }
 
 void NetworkConnection::initializeWeight(double weight, bool adjustPenThickness)
 {
+    if (m_weightMatrix != nullptr)
+        m_weightMatrix->setConnectionWeight(m_weightRow, m_weightColumn, weight);
+
     // Set limits before calling setWeight() as it may use them to update the thickness
     m_minWeight = m_maxWeight = weight;
 
@@ -28,6 +28,8 @@
 #include <QPointer>
 #include <QVariantAnimation>
 
+#include "networkweightmatrix.h"
+
 class NetworkNeuron;
 
 class NetworkConnection : public QObject, public QGraphicsLineItem
@@ -47,6 +49,10 @@ public:
     void setWeight(double weight, bool adjustPenThickness = true);
     void initializeWeight(double weight, bool adjustPenThickness = true);
 
+    void setWeightSource(NetworkWeightMatrix* matrix, int row, int column);
+    bool syncWeight(const NetworkWeightMatrix& matrix, bool adjustPenThickness = true,
+                    bool notify = true);
+
     double minWeight() const;
     double maxWeight() const;
     void setWeightRange(double min, double max, bool adjustPenThickness = true);
@@ -79,9 +85,13 @@ private slots:
 private:
     QPen createPen();
     void init();
+    bool updateWeight(double weight, bool adjustPenThickness, bool notify = true);
 
     QPointer<NetworkNeuron> m_neuron1;
     QPointer<NetworkNeuron> m_neuron2;
+    NetworkWeightMatrix* m_weightMatrix = nullptr;
+    int m_weightRow = 0;
+    int m_weightColumn = 0;
     double m_weight;
     double m_oldWeight;
     double m_minWeight;
@@ -51,8 +51,13 @@ public:
         // Training options
         //
         ActivationFunction,     // Uses MLPActivation::Function
+        ActivationPrecision,    // Uses MLPActivation::Precision
+        EvaluationInterval,
+        EvaluationMode,         // Uses NetworkInfo::EvaluationMode
+        EvaluationPrecision,    // Uses NetworkInfo::EvaluationPrecision
         LearningRate,
         MaxEpochs,
+        Optimizer,              // Uses NetworkInfo::Optimizer
         PauseAfterSample,
         SampleSelectionOrder,   // Uses NetworkInfo::SampleSelectionOrder
         StopError,
@@ -61,7 +66,18 @@ public:
         //
         // Network-specific training options
         //
-        TrainRBFLayer
+        BatchSize,
+        ClusteringBatchSize,
+        ClusteringEpsilon,
+        ClusteringMethod,       // Uses NetworkInfo::ClusteringMethod
+        ClusteringRestarts,
+        ClusteringTolerance,
+        KohonenTrainingMode,    // Uses NetworkInfo::KohonenTrainingMode
+        LearningRateSchedule,   // Uses NetworkInfo::Schedule
+        NeighborhoodSchedule,   // Uses NetworkInfo::Schedule
+        RidgeRegularization,
+        TrainRBFLayer,
+        TrainingMethod          // Uses NetworkInfo::TrainingMethod
     };
     Q_ENUM(Key)
 
@@ -99,6 +115,109 @@ public:
     };
     Q_ENUM(SampleSelectionOrder)
 
+    //
+    // How often the error of a supervised network is evaluated during training
+    //
+    enum class EvaluationMode {
+        //
+        // The "Unknown" mode is used as an error indicator
+        //
+        Unknown,
+        EverySample,
+        Interval,
+        TrainingSet,
+        MovingAverage
+    };
+    Q_ENUM(EvaluationMode)
+
+    //
+    // Floating-point precision used to compute the outputs when the error of a
+    // supervised network is evaluated
+    //
+    enum class EvaluationPrecision {
+        //
+        // The "Unknown" precision is used as an error indicator
+        //
+        Unknown,
+        Double,
+        Single
+    };
+    Q_ENUM(EvaluationPrecision)
+
+    //
+    // Rule used to update the weights from the gradient of the error
+    //
+    enum class Optimizer {
+        //
+        // The "Unknown" optimizer is used as an error indicator
+        //
+        Unknown,
+        SGD,
+        Momentum,
+        RMSProp,
+        Adam
+    };
+    Q_ENUM(Optimizer)
+
+    //
+    // How a training parameter of the Kohonen network decreases over the
+    // training epochs
+    //
+    enum class Schedule {
+        //
+        // The "Unknown" schedule is used as an error indicator
+        //
+        Unknown,
+        Constant,
+        Linear,
+        Exponential,
+        InverseTime,
+        Piecewise
+    };
+    Q_ENUM(Schedule)
+
+    //
+    // Whether the Kohonen network updates the weights after every sample or
+    // once per pass over the training set
+    //
+    enum class KohonenTrainingMode {
+        //
+        // The "Unknown" mode is used as an error indicator
+        //
+        Unknown,
+        Online,
+        Batch
+    };
+    Q_ENUM(KohonenTrainingMode)
+
+    //
+    // Whether the k-means clustering placing the RBF centers uses all training
+    // samples in every iteration or random mini-batches of them
+    //
+    enum class ClusteringMethod {
+        //
+        // The "Unknown" method is used as an error indicator
+        //
+        Unknown,
+        Full,
+        MiniBatch
+    };
+    Q_ENUM(ClusteringMethod)
+
+    //
+    // Whether the linear output weights of the Adaline and RBF networks are adjusted
+    // after every sample or solved directly from the whole training set
+    //
+    enum class TrainingMethod {
+        //
+        // The "Unknown" method is used as an error indicator
+        //
+        Unknown,
+        LMS,
+        Solve
+    };
+    Q_ENUM(TrainingMethod)
+
     using Map = QMap<Key, QVariant>;
 
     virtual const Map& infoMap() const = 0;
@@ -240,6 +359,540 @@ public:
 
         return -1;
     }
+
+    //
+    // Retrieve a list of evaluation modes
+    //
+    static QStringList evaluationModeStringList() {
+        auto list = QStringList();
+        list << QObject::tr("After every training sample");
+        list << QObject::tr("After a number of training samples");
+        list << QObject::tr("After every pass through the training set");
+        list << QObject::tr("Moving average of the trained samples");
+        return list;
+    }
+
+    //
+    // Convert between evaluation mode and index
+    //
+    static EvaluationMode evaluationModeFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return EvaluationMode::EverySample;
+            case 1:
+                return EvaluationMode::Interval;
+            case 2:
+                return EvaluationMode::TrainingSet;
+            case 3:
+                return EvaluationMode::MovingAverage;
+            default:
+                break;
+        }
+        return EvaluationMode::Unknown;
+    }
+    static int evaluationModeToIndex(EvaluationMode mode) {
+        switch (mode) {
+            case EvaluationMode::EverySample:
+                return 0;
+            case EvaluationMode::Interval:
+                return 1;
+            case EvaluationMode::TrainingSet:
+                return 2;
+            case EvaluationMode::MovingAverage:
+                return 3;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert between evaluation mode and string
+    //
+    static EvaluationMode evaluationModeFromString(const QString& modeString) {
+        QString modeLower = modeString.toLower();
+        if (modeLower == "every-sample")
+            return EvaluationMode::EverySample;
+        else if (modeLower == "interval")
+            return EvaluationMode::Interval;
+        else if (modeLower == "training-set")
+            return EvaluationMode::TrainingSet;
+        else if (modeLower == "moving-average")
+            return EvaluationMode::MovingAverage;
+        return EvaluationMode::Unknown;
+    }
+    static QString evaluationModeToString(EvaluationMode mode) {
+        switch (mode) {
+            case EvaluationMode::EverySample:
+                return "every-sample";
+            case EvaluationMode::Interval:
+                return "interval";
+            case EvaluationMode::TrainingSet:
+                return "training-set";
+            case EvaluationMode::MovingAverage:
+                return "moving-average";
+            case EvaluationMode::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    static EvaluationMode evaluationModeFromMap(const Map& map) {
+        if (map.contains(Key::EvaluationMode))
+            return map.value(Key::EvaluationMode).value<EvaluationMode>();
+
+        return EvaluationMode::Unknown;
+    }
+    static int evaluationModeIndexFromMap(const Map& map) {
+        if (map.contains(Key::EvaluationMode))
+            return evaluationModeToIndex(evaluationModeFromMap(map));
+
+        return -1;
+    }
+
+    //
+    // Retrieve a list of evaluation precisions
+    //
+    static QStringList evaluationPrecisionStringList() {
+        auto list = QStringList();
+        list << QObject::tr("Double precision");
+        list << QObject::tr("Single precision");
+        return list;
+    }
+
+    //
+    // Convert between evaluation precision and index
+    //
+    static EvaluationPrecision evaluationPrecisionFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return EvaluationPrecision::Double;
+            case 1:
+                return EvaluationPrecision::Single;
+            default:
+                break;
+        }
+        return EvaluationPrecision::Unknown;
+    }
+    static int evaluationPrecisionToIndex(EvaluationPrecision precision) {
+        switch (precision) {
+            case EvaluationPrecision::Double:
+                return 0;
+            case EvaluationPrecision::Single:
+                return 1;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert between evaluation precision and string
+    //
+    static EvaluationPrecision evaluationPrecisionFromString(const QString& precisionString) {
+        QString precisionLower = precisionString.toLower();
+        if (precisionLower == "double")
+            return EvaluationPrecision::Double;
+        else if (precisionLower == "single")
+            return EvaluationPrecision::Single;
+        return EvaluationPrecision::Unknown;
+    }
+    static QString evaluationPrecisionToString(EvaluationPrecision precision) {
+        switch (precision) {
+            case EvaluationPrecision::Double:
+                return "double";
+            case EvaluationPrecision::Single:
+                return "single";
+            case EvaluationPrecision::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    static EvaluationPrecision evaluationPrecisionFromMap(const Map& map) {
+        if (map.contains(Key::EvaluationPrecision))
+            return map.value(Key::EvaluationPrecision).value<EvaluationPrecision>();
+
+        return EvaluationPrecision::Unknown;
+    }
+
+    //
+    // Retrieve a list of optimizers
+    //
+    static QStringList optimizerStringList() {
+        auto list = QStringList();
+        list << QObject::tr("Gradient descent");
+        list << QObject::tr("Gradient descent with momentum");
+        list << QObject::tr("RMSProp");
+        list << QObject::tr("Adam");
+        return list;
+    }
+
+    //
+    // Convert between optimizer and index
+    //
+    static Optimizer optimizerFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return Optimizer::SGD;
+            case 1:
+                return Optimizer::Momentum;
+            case 2:
+                return Optimizer::RMSProp;
+            case 3:
+                return Optimizer::Adam;
+            default:
+                break;
+        }
+        return Optimizer::Unknown;
+    }
+    static int optimizerToIndex(Optimizer optimizer) {
+        switch (optimizer) {
+            case Optimizer::SGD:
+                return 0;
+            case Optimizer::Momentum:
+                return 1;
+            case Optimizer::RMSProp:
+                return 2;
+            case Optimizer::Adam:
+                return 3;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert between optimizer and string
+    //
+    static Optimizer optimizerFromString(const QString& optimizerString) {
+        QString optimizerLower = optimizerString.toLower();
+        if (optimizerLower == "sgd")
+            return Optimizer::SGD;
+        else if (optimizerLower == "momentum")
+            return Optimizer::Momentum;
+        else if (optimizerLower == "rmsprop")
+            return Optimizer::RMSProp;
+        else if (optimizerLower == "adam")
+            return Optimizer::Adam;
+        return Optimizer::Unknown;
+    }
+    static QString optimizerToString(Optimizer optimizer) {
+        switch (optimizer) {
+            case Optimizer::SGD:
+                return "sgd";
+            case Optimizer::Momentum:
+                return "momentum";
+            case Optimizer::RMSProp:
+                return "rmsprop";
+            case Optimizer::Adam:
+                return "adam";
+            case Optimizer::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    static Optimizer optimizerFromMap(const Map& map) {
+        if (map.contains(Key::Optimizer))
+            return map.value(Key::Optimizer).value<Optimizer>();
+
+        return Optimizer::Unknown;
+    }
+
+    //
+    // Retrieve a list of schedules
+    //
+    static QStringList scheduleStringList() {
+        auto list = QStringList();
+        list << QObject::tr("Constant");
+        list << QObject::tr("Linear decay");
+        list << QObject::tr("Exponential decay");
+        list << QObject::tr("Inverse-time decay");
+        list << QObject::tr("Piecewise linear decay");
+        return list;
+    }
+
+    //
+    // Convert between schedule and index
+    //
+    static Schedule scheduleFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return Schedule::Constant;
+            case 1:
+                return Schedule::Linear;
+            case 2:
+                return Schedule::Exponential;
+            case 3:
+                return Schedule::InverseTime;
+            case 4:
+                return Schedule::Piecewise;
+            default:
+                break;
+        }
+        return Schedule::Unknown;
+    }
+    static int scheduleToIndex(Schedule schedule) {
+        switch (schedule) {
+            case Schedule::Constant:
+                return 0;
+            case Schedule::Linear:
+                return 1;
+            case Schedule::Exponential:
+                return 2;
+            case Schedule::InverseTime:
+                return 3;
+            case Schedule::Piecewise:
+                return 4;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert between schedule and string
+    //
+    static Schedule scheduleFromString(const QString& scheduleString) {
+        QString scheduleLower = scheduleString.toLower();
+        if (scheduleLower == "constant")
+            return Schedule::Constant;
+        else if (scheduleLower == "linear")
+            return Schedule::Linear;
+        else if (scheduleLower == "exponential")
+            return Schedule::Exponential;
+        else if (scheduleLower == "inverse-time")
+            return Schedule::InverseTime;
+        else if (scheduleLower == "piecewise")
+            return Schedule::Piecewise;
+        return Schedule::Unknown;
+    }
+    static QString scheduleToString(Schedule schedule) {
+        switch (schedule) {
+            case Schedule::Constant:
+                return "constant";
+            case Schedule::Linear:
+                return "linear";
+            case Schedule::Exponential:
+                return "exponential";
+            case Schedule::InverseTime:
+                return "inverse-time";
+            case Schedule::Piecewise:
+                return "piecewise";
+            case Schedule::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    //
+    // Both the learning rate and the neighborhood schedules are stored in the map
+    //
+    static Schedule scheduleFromMap(const Map& map, Key key) {
+        if (map.contains(key))
+            return map.value(key).value<Schedule>();
+
+        return Schedule::Unknown;
+    }
+
+    //
+    // Retrieve a list of Kohonen training modes
+    //
+    static QStringList kohonenTrainingModeStringList() {
+        auto list = QStringList();
+        list << QObject::tr("Online (after every training sample)");
+        list << QObject::tr("Batch (after every pass over the training set)");
+        return list;
+    }
+
+    //
+    // Convert between Kohonen training mode and index
+    //
+    static KohonenTrainingMode kohonenTrainingModeFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return KohonenTrainingMode::Online;
+            case 1:
+                return KohonenTrainingMode::Batch;
+            default:
+                break;
+        }
+        return KohonenTrainingMode::Unknown;
+    }
+    static int kohonenTrainingModeToIndex(KohonenTrainingMode mode) {
+        switch (mode) {
+            case KohonenTrainingMode::Online:
+                return 0;
+            case KohonenTrainingMode::Batch:
+                return 1;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert between Kohonen training mode and string
+    //
+    static KohonenTrainingMode kohonenTrainingModeFromString(const QString& modeString) {
+        QString modeLower = modeString.toLower();
+        if (modeLower == "online")
+            return KohonenTrainingMode::Online;
+        else if (modeLower == "batch")
+            return KohonenTrainingMode::Batch;
+        return KohonenTrainingMode::Unknown;
+    }
+    static QString kohonenTrainingModeToString(KohonenTrainingMode mode) {
+        switch (mode) {
+            case KohonenTrainingMode::Online:
+                return "online";
+            case KohonenTrainingMode::Batch:
+                return "batch";
+            case KohonenTrainingMode::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    static KohonenTrainingMode kohonenTrainingModeFromMap(const Map& map) {
+        if (map.contains(Key::KohonenTrainingMode))
+            return map.value(Key::KohonenTrainingMode).value<KohonenTrainingMode>();
+
+        return KohonenTrainingMode::Unknown;
+    }
+
+    //
+    // Retrieve a list of clustering methods
+    //
+    static QStringList clusteringMethodStringList() {
+        auto list = QStringList();
+        list << QObject::tr("Full (all training samples in every iteration)");
+        list << QObject::tr("Mini-batch (random training samples in every iteration)");
+        return list;
+    }
+
+    //
+    // Convert between clustering method and index
+    //
+    static ClusteringMethod clusteringMethodFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return ClusteringMethod::Full;
+            case 1:
+                return ClusteringMethod::MiniBatch;
+            default:
+                break;
+        }
+        return ClusteringMethod::Unknown;
+    }
+    static int clusteringMethodToIndex(ClusteringMethod method) {
+        switch (method) {
+            case ClusteringMethod::Full:
+                return 0;
+            case ClusteringMethod::MiniBatch:
+                return 1;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert between clustering method and string
+    //
+    static ClusteringMethod clusteringMethodFromString(const QString& methodString) {
+        QString methodLower = methodString.toLower();
+        if (methodLower == "full")
+            return ClusteringMethod::Full;
+        else if (methodLower == "mini-batch")
+            return ClusteringMethod::MiniBatch;
+        return ClusteringMethod::Unknown;
+    }
+    static QString clusteringMethodToString(ClusteringMethod method) {
+        switch (method) {
+            case ClusteringMethod::Full:
+                return "full";
+            case ClusteringMethod::MiniBatch:
+                return "mini-batch";
+            case ClusteringMethod::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    static ClusteringMethod clusteringMethodFromMap(const Map& map) {
+        if (map.contains(Key::ClusteringMethod))
+            return map.value(Key::ClusteringMethod).value<ClusteringMethod>();
+
+        return ClusteringMethod::Unknown;
+    }
+
+    //
+    // Retrieve a list of training methods
+    //
+    static QStringList trainingMethodStringList() {
+        auto list = QStringList();
+        list << QObject::tr("Least mean squares (adjust the weights after every sample)");
+        list << QObject::tr("Solve (compute the weights from all training samples at once)");
+        return list;
+    }
+
+    //
+    // Convert between training method and index
+    //
+    static TrainingMethod trainingMethodFromIndex(int index) {
+        switch (index) {
+            case 0:
+                return TrainingMethod::LMS;
+            case 1:
+                return TrainingMethod::Solve;
+            default:
+                break;
+        }
+        return TrainingMethod::Unknown;
+    }
+    static int trainingMethodToIndex(TrainingMethod method) {
+        switch (method) {
+            case TrainingMethod::LMS:
+                return 0;
+            case TrainingMethod::Solve:
+                return 1;
+            default:
+                break;
+        }
+        return -1;
+    }
+
+    //
+    // Convert between training method and string
+    //
+    static TrainingMethod trainingMethodFromString(const QString& methodString) {
+        QString methodLower = methodString.toLower();
+        if (methodLower == "lms")
+            return TrainingMethod::LMS;
+        else if (methodLower == "solve")
+            return TrainingMethod::Solve;
+        return TrainingMethod::Unknown;
+    }
+    static QString trainingMethodToString(TrainingMethod method) {
+        switch (method) {
+            case TrainingMethod::LMS:
+                return "lms";
+            case TrainingMethod::Solve:
+                return "solve";
+            case TrainingMethod::Unknown:
+                break;
+        }
+        return "unknown";
+    }
+
+    static TrainingMethod trainingMethodFromMap(const Map& map) {
+        if (map.contains(Key::TrainingMethod))
+            return map.value(Key::TrainingMethod).value<TrainingMethod>();
+
+        return TrainingMethod::Unknown;
+    }
 };
 
 inline QDebug operator<<(QDebug debug, NetworkInfo::Type type) {
@@ -19,6 +19,8 @@
  */
 #include "networklayer.h"
 
+#include <QThread>
+
 NetworkLayer::NetworkLayer(NetworkLayerInfo::Type type, Network* parent) :
     NetworkLayer(NetworkLayerInfo::Map(), parent)
 {
@@ -128,12 +130,25 @@ QStringList NetworkLayer::neuronNameList(bool skipBias) const
 // Connect every neuron in this layer to every neuron in the given
 // target layer
 //
-void NetworkLayer::connectTo(const NetworkLayer* nextLayer)
+// The weights of the new connections are stored in the weight matrix of the
+// target layer.
+//
+void NetworkLayer::connectTo(NetworkLayer* nextLayer)
 {
     QVector<NetworkConnection*> connections;
     double min = qInf();
     double max = -qInf();
 
+    auto& matrix = nextLayer->m_inWeights;
+    matrix.resize(nextLayer->neuronCount(true), neuronCount(true), hasBias());
+    //
+    // Layers too large to draw every connection only keep the weights
+    //
+    const bool createItems = nextLayer->hasInConnectionItems();
+
+    int biasOffset = hasBias() ? 1 : 0;
+    int nextBiasOffset = nextLayer->hasBias() ? 1 : 0;
+
     for (int i = 0; i < m_neurons.size(); i++) {
         auto* neuron1 = m_neurons.at(i);
         for (int j = 0; j < nextLayer->neurons().size(); j++) {
@@ -154,7 +169,17 @@ void NetworkLayer::connectTo(const NetworkLayer* nextLayer)
             min = qMin(min, weight);
             max = qMax(max, weight);
 
+            //
+            // The bias neuron maps to NetworkWeightMatrix::BiasColumn
+            //
+            int row = j - nextBiasOffset;
+            int column = i - biasOffset;
+            matrix.setConnectionWeight(row, column, weight);
+            if (!createItems)
+                continue;
+
             auto* conn = new NetworkConnection(neuron1, neuron2, weight, this);
+            conn->setWeightSource(&matrix, row, column);
             neuron1->addOutConnection(conn);
             neuron2->addInConnection(conn);
 
@@ -166,9 +191,85 @@ void NetworkLayer::connectTo(const NetworkLayer* nextLayer)
     for (auto* conn : connections)
         conn->setWeightRange(min, max);
 
+    if (!createItems)
+        nextLayer->m_displayedInWeights = matrix;
+
+    m_nextLayer = nextLayer;
+    nextLayer->m_previousLayer = this;
+
     qDebug() << "Connected layer" << name() << "to" << nextLayer->name();
 }
 
+//
+// Retrieve the layer connected to the input of this layer, if any
+//
+NetworkLayer* NetworkLayer::previousLayer() const
+{
+    return m_previousLayer;
+}
+
+//
+// Retrieve the layer connected to the output of this layer, if any
+//
+NetworkLayer* NetworkLayer::nextLayer() const
+{
+    return m_nextLayer;
+}
+
+//
+// Retrieve the weights of connections coming from the previous layer
+//
+NetworkWeightMatrix& NetworkLayer::inWeights()
+{
+    return m_inWeights;
+}
+
+const NetworkWeightMatrix& NetworkLayer::inWeights() const
+{
+    return m_inWeights;
+}
+
+const NetworkSingleWeightMatrix& NetworkLayer::singleInWeights() const
+{
+    return m_singleInWeights;
+}
+
+//
+// Copy the weights to the single-precision weight matrix
+//
+void NetworkLayer::updateSingleInWeights()
+{
+    m_singleInWeights.assign(m_inWeights);
+}
+
+//
+// Return the number of weights of the incoming connections of the given neuron
+//
+int NetworkLayer::neuronInWeightCount(int index) const
+{
+    if (hasInConnectionItems())
+        return m_neurons.at(index)->inConnectionCount();
+
+    if (m_neurons.at(index)->isBias() || m_displayedInWeights.isEmpty())
+        return 0;
+
+    return m_displayedInWeights.columns() + (m_displayedInWeights.hasBias() ? 1 : 0);
+}
+
+//
+// Return the displayed weight of the connection from the given neuron of the previous
+// layer, the neurons are numbered including the bias like the connections
+//
+double NetworkLayer::neuronInWeight(int index, int input) const
+{
+    if (hasInConnectionItems())
+        return m_neurons.at(index)->inConnection(input)->weight();
+
+    int row = index - (hasBias() ? 1 : 0);
+    int column = input - (m_displayedInWeights.hasBias() ? 1 : 0);
+    return m_displayedInWeights.connectionWeight(row, column);
+}
+
 //
 // Append neuron to the layer
 //
@@ -177,6 +278,8 @@ void NetworkLayer::addNeuron(NetworkNeuron *neuron, bool setDefaultNeuronName)
     int index = m_neurons.size();
 
     m_neurons.append(neuron);
+    if (!neuron->isBias())
+        m_activations.append(neuron->value());
     if (setDefaultNeuronName)
         neuron->setName(defaultNeuronName(index));
 
@@ -194,6 +297,7 @@ void NetworkLayer::addNeuron(NetworkNeuron *neuron, bool setDefaultNeuronName)
     connect(neuron, &NetworkNeuron::inWeightChanged, this,
             [this, index] {
         emit neuronWeightChanged(index);
+        emit inWeightsChanged();
     });
     connect(neuron, &NetworkNeuron::outWeightChanged, this,
             [this, index] {
@@ -219,6 +323,8 @@ bool NetworkLayer::hasBias() const
 
 void NetworkLayer::resetNeuronValues()
 {
+    m_activations.fill(0.0);
+
     if (hasBias()) {
         for (int i = 1; i < neuronCount(); i++)
             m_neurons.at(i)->resetValue();
@@ -236,35 +342,35 @@ void NetworkLayer::setDefaultNeuronNames()
 
 QVector<double> NetworkLayer::values(bool skipBias) const
 {
-    QVector<double> values;
+    if (skipBias || !hasBias())
+        return m_activations;
 
-    for (auto* neuron : qAsConst(m_neurons)) {
-        if (skipBias && neuron->isBias())
-            continue;
-        values.append(neuron->value());
-    }
+    QVector<double> values;
+    values.reserve(m_activations.size() + 1);
+    values.append(1.0);
+    values.append(m_activations);
     return values;
 }
 
 //
 // Assign values to neurons in this layer
 //
-// If the layer includes a bias neurons, the value vector may or may not include it.
-// If bias is included, it will be skipped over.
+// The value vector must not include the bias neuron.
 //
 void NetworkLayer::setValues(const QVector<double>& values)
 {
-    if (hasBias()) {
-        Q_ASSERT(values.size() == neuronCount() - 1);
+    Q_ASSERT(values.size() == m_activations.size());
 
-        for (int i = 1; i < neuronCount(); i++)
-            m_neurons.at(i)->setValue(values[i - 1]);
-    } else {
-        Q_ASSERT(values.size() == neuronCount());
+    m_activations = values;
+    syncNeuronValues();
+}
 
-        for (int i = 0; i < neuronCount(); i++)
-            m_neurons.at(i)->setValue(values[i]);
-    }
+//
+// Retrieve the current values of the non-bias neurons
+//
+const QVector<double>& NetworkLayer::activations() const
+{
+    return m_activations;
 }
 
 void NetworkLayer::setInConnectionWeights(double value)
@@ -272,6 +378,12 @@ void NetworkLayer::setInConnectionWeights(double value)
     if (!inConnectionWeightsSettable())
         return;
 
+    if (!hasInConnectionItems()) {
+        std::function<double()> fn = [value] { return value; };
+        fillInWeights(fn);
+        return;
+    }
+
     for (int i = 0; i < m_neurons.size(); i++)
         m_neurons.at(i)->setInConnectionWeights(value);
 }
@@ -281,6 +393,11 @@ void NetworkLayer::setInConnectionWeights(std::function<double()>& fn, bool upda
     if (!inConnectionWeightsSettable())
         return;
 
+    if (!hasInConnectionItems()) {
+        fillInWeights(fn);
+        return;
+    }
+
     for (int i = 0; i < m_neurons.size(); i++)
         m_neurons.at(i)->setInConnectionWeights(fn);
 
@@ -293,6 +410,11 @@ void NetworkLayer::setOutConnectionWeights(double value)
     if (!outConnectionWeightsSettable())
         return;
 
+    if (m_nextLayer != nullptr && !m_nextLayer->hasInConnectionItems()) {
+        m_nextLayer->setInConnectionWeights(value);
+        return;
+    }
+
     for (int i = 0; i < m_neurons.size(); i++)
         m_neurons.at(i)->setOutConnectionWeights(value);
 }
@@ -302,6 +424,11 @@ void NetworkLayer::setOutConnectionWeights(std::function<double()>& fn, bool upd
     if (!outConnectionWeightsSettable())
         return;
 
+    if (m_nextLayer != nullptr && !m_nextLayer->hasInConnectionItems()) {
+        m_nextLayer->setInConnectionWeights(fn, updateRange);
+        return;
+    }
+
     for (int i = 0; i < m_neurons.size(); i++)
         m_neurons.at(i)->setOutConnectionWeights(fn);
 
@@ -333,6 +460,29 @@ bool NetworkLayer::outConnectionWeightsSettable() const
     return true;
 }
 
+//
+// Return false if the incoming connections are not drawn one by one, the layer
+// then only has the weight matrix and displays the weights in its own way
+//
+bool NetworkLayer::hasInConnectionItems() const
+{
+    return true;
+}
+
+//
+// Set the weights of a layer without connection items directly in the weight matrix
+//
+void NetworkLayer::fillInWeights(std::function<double()>& fn)
+{
+    for (int row = 0; row < m_inWeights.rows(); row++) {
+        if (m_inWeights.hasBias())
+            m_inWeights.setBias(row, fn());
+        for (int column = 0; column < m_inWeights.columns(); column++)
+            m_inWeights.setWeight(row, column, fn());
+    }
+    syncInConnectionWeights();
+}
+
 void NetworkLayer::updateInConnectionRange()
 {
     QVector<NetworkConnection*> allConnections;
@@ -368,3 +518,73 @@ void NetworkLayer::updateOutConnectionRange()
     for (auto* conn : qAsConst(allConnections))
         conn->setWeightRange(min, max);
 }
+
+//
+// Copy the computed values to the neurons.
+//
+// Nothing is done when called from the training thread, the values are displayed
+// from the snapshots published by the thread.
+//
+void NetworkLayer::syncNeuronValues()
+{
+    if (QThread::currentThread() != thread())
+        return;
+
+    applyNeuronValues(m_activations);
+}
+
+//
+// Copy the weights from the weight matrix to the incoming connections.
+//
+// Nothing is done when called from the training thread, the weights are displayed
+// from the snapshots published by the thread.
+//
+void NetworkLayer::syncInConnectionWeights(bool updateRange)
+{
+    if (QThread::currentThread() != thread())
+        return;
+
+    applyInConnectionWeights(m_inWeights, updateRange);
+}
+
+//
+// Display the given values of the non-bias neurons
+//
+void NetworkLayer::applyNeuronValues(const QVector<double>& values)
+{
+    Q_ASSERT(values.size() == m_activations.size());
+
+    int offset = hasBias() ? 1 : 0;
+    for (int i = 0; i < values.size(); i++)
+        m_neurons.at(i + offset)->setValue(values.at(i));
+}
+
+//
+// Display the given weights of the incoming connections.
+//
+// The connections do not announce their changes one by one, a single
+// inWeightsChanged() signal is emitted for the whole layer instead.
+//
+void NetworkLayer::applyInConnectionWeights(const NetworkWeightMatrix& weights, bool updateRange)
+{
+    //
+    // Without connection items the weights are only kept for display and assumed
+    // to change
+    //
+    bool changed = false;
+    if (!hasInConnectionItems()) {
+        m_displayedInWeights = weights;
+        changed = true;
+    }
+    for (const auto* neuron : qAsConst(m_neurons)) {
+        const auto& inConnections = neuron->inConnections();
+        for (auto* conn : inConnections) {
+            if (conn->syncWeight(weights, !updateRange, false))
+                changed = true;
+        }
+    }
+    if (updateRange)
+        updateInConnectionRange();
+    if (changed)
+        emit inWeightsChanged();
+}
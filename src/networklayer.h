@@ -34,6 +34,7 @@ class NetworkLayer;
 #include "network.h"
 #include "networklayerinfo.h"
 #include "networkneuron.h"
+#include "networkweightmatrix.h"
 
 class NetworkLayer : public QObject, public QGraphicsItemGroup, public NetworkLayerInfo
 {
@@ -53,7 +54,10 @@ public:
     NetworkNeuron* neuron(int index) const;
     virtual int neuronCount(bool skipBias = false) const;
 
-    virtual void connectTo(const NetworkLayer *nextLayer);
+    virtual void connectTo(NetworkLayer *nextLayer);
+
+    NetworkLayer* previousLayer() const;
+    NetworkLayer* nextLayer() const;
 
     void addNeuron(NetworkNeuron *neuron, bool setDefaultNeuronName = false);
 
@@ -64,6 +68,15 @@ public:
 
     QVector<double> values(bool skipBias = false) const;
     void setValues(const QVector<double>& values);
+    const QVector<double>& activations() const;
+
+    NetworkWeightMatrix& inWeights();
+    const NetworkWeightMatrix& inWeights() const;
+    const NetworkSingleWeightMatrix& singleInWeights() const;
+    void updateSingleInWeights();
+
+    int neuronInWeightCount(int index) const;
+    double neuronInWeight(int index, int input) const;
 
     void setInConnectionWeights(double value);
     void setInConnectionWeights(std::function<double()>& fn, bool updateRange = true);
@@ -77,14 +90,19 @@ public:
     void setDefaultNeuronNames();
 
     void setShowConnectionWeights(bool enabled, bool setForInputs = true, bool setForOutputs = true);
-    void setShowNeuronValues(bool enabled);
+    virtual void setShowNeuronValues(bool enabled);
 
     virtual bool inConnectionWeightsSettable() const;
     virtual bool outConnectionWeightsSettable() const;
+    virtual bool hasInConnectionItems() const;
 
 public slots:
     void updateInConnectionRange();
     void updateOutConnectionRange();
+    void syncNeuronValues();
+    void syncInConnectionWeights(bool updateRange = true);
+    virtual void applyNeuronValues(const QVector<double>& values);
+    void applyInConnectionWeights(const NetworkWeightMatrix& weights, bool updateRange = true);
 
 signals:
     void nameChanged(const QString& name);
@@ -92,15 +110,37 @@ signals:
     void neuronNameChanged(int index);
     void neuronValueChanged(int index);
     void neuronWeightChanged(int index);
+    void inWeightsChanged();
     void neuronStatusMessage(int index, const QString& message);
 
 protected:
     virtual QString defaultNeuronName(int index) const;
+    void fillInWeights(std::function<double()>& fn);
 
     NetworkLayerInfo::Map m_infoMap;
+    //
+    // Values of the non-bias neurons and the weights of the incoming connections,
+    // these are used by the computation and copied to the neurons and connections
+    // by syncNeuronValues() and syncInConnectionWeights().
+    //
+    // While the network is being trained these are owned by the training thread.
+    //
+    QVector<double> m_activations;
+    NetworkWeightMatrix m_inWeights;
+    //
+    // Single-precision copy of the weights, see Network::updateSingleWeights()
+    //
+    NetworkSingleWeightMatrix m_singleInWeights;
+    //
+    // Weights currently displayed by the layer, these stand in for the weights
+    // of the connections when the layer does not have connection items
+    //
+    NetworkWeightMatrix m_displayedInWeights;
 
 private:
     bool m_changing = false;
     std::function<double()> m_initialWeight;
     QVector<NetworkNeuron *> m_neurons;
+    NetworkLayer* m_previousLayer = nullptr;
+    NetworkLayer* m_nextLayer = nullptr;
 };
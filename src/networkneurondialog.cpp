@@ -81,8 +81,8 @@ void NetworkNeuronDialog::init()
             auto* conn = m_neuron->inConnection(i);
             auto* spinBox = new NetworkNeuronDialogSpinBox(network, conn, this);
 
-            connect(conn, &NetworkConnection::weightChanged, this, [spinBox](double value) {
-                spinBox->setValue(value);
+            connect(network, &Network::weightsUpdated, this, [spinBox, conn] {
+                spinBox->setValue(conn->weight());
             });
             ui->formLayout->insertRow(1 + inputRow++, conn->neuron1()->name() + ":", spinBox);
 
@@ -99,8 +99,8 @@ void NetworkNeuronDialog::init()
             auto* conn = m_neuron->outConnection(i);
             auto* spinBox = new NetworkNeuronDialogSpinBox(network, conn, this);
 
-            connect(conn, &NetworkConnection::weightChanged, this, [spinBox](double value) {
-                spinBox->setValue(value);
+            connect(network, &Network::weightsUpdated, this, [spinBox, conn] {
+                spinBox->setValue(conn->weight());
             });
             ui->formLayout->insertRow(1 + outputRow++, conn->neuron2()->name() + ":", spinBox);
 
@@ -20,6 +20,7 @@
 #include "networkneurondialogspinbox.h"
 
 #include <limits>
+#include <QMutexLocker>
 
 NetworkNeuronDialogSpinBox::NetworkNeuronDialogSpinBox(Network* network, NetworkConnection* conn, QWidget* parent) :
     QDoubleSpinBox(parent),
@@ -48,5 +49,6 @@ void NetworkNeuronDialogSpinBox::init()
 
 void NetworkNeuronDialogSpinBox::save()
 {
+    QMutexLocker locker(&m_network->trainingMutex());
     m_connection->setWeight(value());
 }
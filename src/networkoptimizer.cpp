@@ -0,0 +1,163 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "networkoptimizer.h"
+
+#include <cmath>
+
+#include "vectorkernels.h"
+
+NetworkInfo::Optimizer NetworkOptimizer::type() const
+{
+    return m_requestedType;
+}
+
+void NetworkOptimizer::setType(NetworkInfo::Optimizer type)
+{
+    Q_ASSERT(type != NetworkInfo::Optimizer::Unknown);
+
+    m_requestedType = type;
+}
+
+double NetworkOptimizer::learningRate() const
+{
+    return m_learningRate;
+}
+
+void NetworkOptimizer::setLearningRate(double learningRate)
+{
+    m_learningRate = learningRate;
+}
+
+bool NetworkOptimizer::isStateless() const
+{
+    return m_type == NetworkInfo::Optimizer::SGD;
+}
+
+void NetworkOptimizer::reset()
+{
+    m_type = m_requestedType;
+    clearState();
+}
+
+void NetworkOptimizer::clearState()
+{
+    m_first.clear();
+    m_second.clear();
+    m_firstBias.clear();
+    m_secondBias.clear();
+    m_steps = 0;
+}
+
+void NetworkOptimizer::beginUpdate(const NetworkWeightMatrix& weights)
+{
+    if (isStateless())
+        return;
+
+    const int size = weights.rows() * weights.columns();
+    if (m_first.size() != size || m_firstBias.size() != weights.rows()) {
+        clearState();
+        m_first.fill(0.0, size);
+        m_firstBias.fill(0.0, weights.rows());
+        if (m_type != NetworkInfo::Optimizer::Momentum) {
+            m_second.fill(0.0, size);
+            m_secondBias.fill(0.0, weights.rows());
+        }
+    }
+    //
+    // Adam corrects the bias of the moments towards zero in the first steps
+    //
+    m_steps++;
+    if (m_type == NetworkInfo::Optimizer::Adam) {
+        m_firstCorrection = 1.0 - std::pow(AdamBeta1, m_steps);
+        m_secondCorrection = 1.0 - std::pow(AdamBeta2, m_steps);
+    }
+}
+
+void NetworkOptimizer::updateRow(NetworkWeightMatrix& weights, int row, double delta,
+                                 const double* input)
+{
+    if (isStateless()) {
+        const double change = m_learningRate * delta;
+
+        VectorKernels::axpy(-change, input, weights.rowData(row), weights.columns());
+        if (weights.hasBias())
+            weights.biasData()[row] -= change;
+        return;
+    }
+    updateRowWith(weights, row, [delta, input](int i) {
+        return delta * input[i];
+    }, delta);
+}
+
+void NetworkOptimizer::updateRow(NetworkWeightMatrix& weights, int row, const double* gradient,
+                                 double biasGradient)
+{
+    if (isStateless()) {
+        VectorKernels::axpy(-m_learningRate, gradient, weights.rowData(row), weights.columns());
+        if (weights.hasBias())
+            weights.biasData()[row] -= m_learningRate * biasGradient;
+        return;
+    }
+    updateRowWith(weights, row, [gradient](int i) {
+        return gradient[i];
+    }, biasGradient);
+}
+
+template<typename Gradient>
+void NetworkOptimizer::updateRowWith(NetworkWeightMatrix& weights, int row, Gradient gradient,
+                                     double biasGradient)
+{
+    const int columns = weights.columns();
+    const int offset = row * columns;
+    double* rowWeights = weights.rowData(row);
+    double* first = m_first.data() + offset;
+    double* second = m_second.isEmpty() ? nullptr : m_second.data() + offset;
+
+    double unused = 0.0;
+    for (int i = 0; i < columns; i++)
+        rowWeights[i] -= step(gradient(i), first[i], second ? second[i] : unused);
+
+    if (weights.hasBias()) {
+        double& secondBias = m_secondBias.isEmpty() ? unused : m_secondBias[row];
+        weights.biasData()[row] -= step(biasGradient, m_firstBias[row], secondBias);
+    }
+}
+
+//
+// Return the change of a single weight with the given gradient and update its state
+//
+double NetworkOptimizer::step(double gradient, double& first, double& second) const
+{
+    switch (m_type) {
+        case NetworkInfo::Optimizer::Momentum:
+            first = Momentum * first + gradient;
+            return m_learningRate * first;
+        case NetworkInfo::Optimizer::RMSProp:
+            second = RMSPropDecay * second + (1.0 - RMSPropDecay) * gradient * gradient;
+            return m_learningRate * gradient / (std::sqrt(second) + Epsilon);
+        case NetworkInfo::Optimizer::Adam:
+            first = AdamBeta1 * first + (1.0 - AdamBeta1) * gradient;
+            second = AdamBeta2 * second + (1.0 - AdamBeta2) * gradient * gradient;
+            return m_learningRate * (first / m_firstCorrection)
+                    / (std::sqrt(second / m_secondCorrection) + Epsilon);
+        default:
+            return m_learningRate * gradient;
+    }
+}
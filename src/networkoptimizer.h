@@ -0,0 +1,102 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QVector>
+
+#include "networkinfo.h"
+#include "networkweightmatrix.h"
+
+//
+// Update rule applied to the incoming weights of a layer.
+//
+// The layers compute the gradient of the error with respect to their weights and
+// the optimizer turns it into the weight changes. The adaptive optimizers keep
+// their state for every weight in buffers with the same layout as the weight
+// matrix, the state is cleared by reset() and whenever the size of the matrix
+// changes.
+//
+// A new rule only takes effect on the next reset(), which the networks do
+// before the training starts, so the rule and its state never change under
+// the training thread.
+//
+class NetworkOptimizer
+{
+public:
+    //
+    // Coefficients of the adaptive optimizers
+    //
+    static constexpr double Momentum = 0.9;
+    static constexpr double RMSPropDecay = 0.9;
+    static constexpr double AdamBeta1 = 0.9;
+    static constexpr double AdamBeta2 = 0.999;
+    static constexpr double Epsilon = 1e-8;
+
+    NetworkInfo::Optimizer type() const;
+    void setType(NetworkInfo::Optimizer type);
+
+    double learningRate() const;
+    void setLearningRate(double learningRate);
+
+    //
+    // Plain gradient descent does not keep any state, so rows with zero gradient
+    // may be skipped
+    //
+    bool isStateless() const;
+
+    void reset();
+    //
+    // Must be called once before the rows of the matrix are updated
+    //
+    void beginUpdate(const NetworkWeightMatrix& weights);
+    //
+    // Update the row whose gradient is delta * input, and delta for the bias
+    //
+    void updateRow(NetworkWeightMatrix& weights, int row, double delta, const double* input);
+    //
+    // Update the row using the given gradient
+    //
+    void updateRow(NetworkWeightMatrix& weights, int row, const double* gradient,
+                   double biasGradient);
+
+private:
+    template<typename Gradient>
+    void updateRowWith(NetworkWeightMatrix& weights, int row, Gradient gradient,
+                       double biasGradient);
+    double step(double gradient, double& first, double& second) const;
+    void clearState();
+
+    NetworkInfo::Optimizer m_type = NetworkInfo::Optimizer::SGD;
+    NetworkInfo::Optimizer m_requestedType = NetworkInfo::Optimizer::SGD;
+    double m_learningRate = 1.0;
+    //
+    // Velocity or the first moment, and the second moment of the gradient, the
+    // bias weights are stored separately like in the weight matrix
+    //
+    QVector<double> m_first;
+    QVector<double> m_second;
+    QVector<double> m_firstBias;
+    QVector<double> m_secondBias;
+    int m_steps = 0;
+    double m_firstCorrection = 1.0;
+    double m_secondCorrection = 1.0;
+};
@@ -125,19 +125,7 @@ void NetworkStatusWidget::init()
                         weightDiffLabel->setText(QString());
                 });
 
-                connect(conn, &NetworkConnection::weightChanged, this,
-                        [this, weightNumberLabel, weightDiffLabel](double weight, double oldWeight) {
-                    if (!m_update)
-                        return;
-                    weightNumberLabel->setNumber(weight);
-                    if (m_network->isTraining()) {
-                        weightDiffLabel->setNumberDiff(weight - oldWeight);
-                        weightDiffLabel->setChanged(true);
-                    } else {
-                        // Don't show the difference on manual updates
-                        weightDiffLabel->setText(QString());
-                    }
-                });
+                m_weightLabels.append({ conn, i + 1, conn->weight(), weightNumberLabel, weightDiffLabel });
                 connect(conn, &NetworkConnection::weightInitialized, this,
                         [this, weightNumberLabel, weightDiffLabel](double weight) {
                     if (!m_update)
@@ -162,6 +150,37 @@ void NetworkStatusWidget::init()
             });
         }
     }
+
+    connect(m_network, &Network::weightsUpdated, this, &NetworkStatusWidget::updateWeightLabels);
+}
+
+//
+// Refresh the labels of the weights in the changed layers
+//
+void NetworkStatusWidget::updateWeightLabels(const QBitArray& layers)
+{
+    if (!m_update)
+        return;
+
+    bool training = m_network->isTraining();
+    for (auto& labels : m_weightLabels) {
+        if (!layers.testBit(labels.layerIndex))
+            continue;
+
+        double weight = labels.connection->weight();
+        if (qFuzzyCompare(weight, labels.weight))
+            continue;
+
+        labels.numberLabel->setNumber(weight);
+        if (training) {
+            labels.diffLabel->setNumberDiff(weight - labels.connection->oldWeight());
+            labels.diffLabel->setChanged(true);
+        } else {
+            // Don't show the difference on manual updates
+            labels.diffLabel->setText(QString());
+        }
+        labels.weight = weight;
+    }
 }
 
 void NetworkStatusWidget::on_checkBoxPauseUpdates_clicked(bool checked)
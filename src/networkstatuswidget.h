@@ -21,9 +21,13 @@
 
 #include "common.h"
 
+#include <QBitArray>
+#include <QVector>
 #include <QWidget>
 
 #include "network.h"
+#include "networkconnection.h"
+#include "networkstatusnumberlabel.h"
 #include "networkvisualwidget.h"
 #include "resettable.h"
 
@@ -46,8 +50,21 @@ private slots:
     void on_checkBoxPauseUpdates_clicked(bool checked);
 
 private:
+    //
+    // Labels showing the weight of a connection and its last change
+    //
+    struct WeightLabels {
+        NetworkConnection* connection;
+        int layerIndex;
+        double weight;
+        NetworkStatusNumberLabel* numberLabel;
+        NetworkStatusNumberLabel* diffLabel;
+    };
+
     void init();
+    void updateWeightLabels(const QBitArray& layers);
 
     Ui::NetworkStatusWidget *ui;
+    QVector<WeightLabels> m_weightLabels;
     bool m_update = true;
 };
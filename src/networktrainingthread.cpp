@@ -0,0 +1,206 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "networktrainingthread.h"
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+NetworkTrainingThread::NetworkTrainingThread(Network* network) :
+    QThread(network),
+    m_network(network)
+{
+}
+
+NetworkTrainingThread::~NetworkTrainingThread()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_quit = true;
+        m_condition.wakeAll();
+    }
+    wait();
+}
+
+//
+// Start training a new generation, returns the generation number
+//
+int NetworkTrainingThread::resumeTraining()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_generation++;
+    m_active = true;
+    m_snapshotPending.storeRelease(0);
+    m_condition.wakeAll();
+
+    return m_generation;
+}
+
+//
+// Stop training after the currently trained sample, if any
+//
+void NetworkTrainingThread::suspendTraining()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_generation++;
+    m_active = false;
+    m_condition.wakeAll();
+}
+
+bool NetworkTrainingThread::isCurrentGeneration(int generation)
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_active && generation == m_generation;
+}
+
+void NetworkTrainingThread::setSampleDelay(int delay)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_sampleDelay = delay;
+    m_condition.wakeAll();
+}
+
+void NetworkTrainingThread::setTurbo(bool enabled)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_turbo = enabled;
+    m_condition.wakeAll();
+}
+
+//
+// Called by the network once a published snapshot has been displayed or dropped
+//
+void NetworkTrainingThread::snapshotConsumed()
+{
+    m_snapshotPending.storeRelease(0);
+}
+
+void NetworkTrainingThread::run()
+{
+    QElapsedTimer snapshotTimer;
+    QMutexLocker locker(&m_mutex);
+
+    forever {
+        while (!m_active && !m_quit)
+            m_condition.wait(&m_mutex);
+        if (m_quit)
+            break;
+
+        int generation = m_generation;
+        bool turbo = m_turbo;
+        locker.unlock();
+
+        int count = turbo ? m_batchSize : 1;
+        int trained = 0;
+        qint64 elapsed = 0;
+        auto reason = Network::StopTrainingReason::UserRequested;
+        auto result = m_network->trainNextSamples(generation, count, &trained, &elapsed, &reason);
+        if (result == Network::TrainingStepResult::Suspended) {
+            locker.relock();
+            continue;
+        }
+        if (turbo)
+            m_batchSize = adjustBatchSize(elapsed, trained);
+        //
+        // Always publish the final state of the run, otherwise limit the rate to
+        // what the GUI can display
+        //
+        bool publish = result != Network::TrainingStepResult::Continue;
+        if (!publish && m_snapshotPending.loadAcquire() == 0) {
+            publish = turbo
+                    || !snapshotTimer.isValid()
+                    || snapshotTimer.elapsed() >= SnapshotInterval;
+        }
+        if (publish) {
+            m_snapshotPending.storeRelease(1);
+            emit snapshotReady(generation, m_network->createSnapshot());
+            snapshotTimer.start();
+        }
+
+        locker.relock();
+        switch (result) {
+            case Network::TrainingStepResult::Continue:
+                if (turbo) {
+                    //
+                    // Give the GUI thread a chance to take the training mutex
+                    //
+                    locker.unlock();
+                    yieldCurrentThread();
+                    locker.relock();
+                } else
+                    waitSampleDelay(generation);
+                break;
+            case Network::TrainingStepResult::Pause:
+                if (generation == m_generation)
+                    m_active = false;
+                emit trainingPaused(generation);
+                break;
+            case Network::TrainingStepResult::Stop:
+                if (generation == m_generation)
+                    m_active = false;
+                emit trainingStopped(generation, reason);
+                break;
+            case Network::TrainingStepResult::Suspended:
+                break;
+        }
+    }
+}
+
+//
+// Wait for the sample delay to pass, the wait is interrupted when the training is
+// suspended. The mutex must be locked.
+//
+void NetworkTrainingThread::waitSampleDelay(int generation)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (m_active && !m_quit && generation == m_generation) {
+        qint64 remaining = m_sampleDelay - timer.elapsed();
+        if (remaining <= 0)
+            break;
+        m_condition.wait(&m_mutex, static_cast<unsigned long>(remaining));
+    }
+}
+
+//
+// Compute the number of samples that fit into the frame budget from the measured
+// cost of the last batch, smoothed to avoid jumps caused by a single slow batch
+//
+int NetworkTrainingThread::adjustBatchSize(qint64 elapsed, int trained)
+{
+    if (trained <= 0)
+        return m_batchSize;
+
+    double cost = static_cast<double>(elapsed) / trained;
+    if (m_sampleCost > 0)
+        m_sampleCost = 0.8 * m_sampleCost + 0.2 * cost;
+    else
+        m_sampleCost = cost;
+
+    double budget = TurboFrameBudget * 1000000.0;
+    double size = budget / qMax(m_sampleCost, 1.0);
+
+    return static_cast<int>(qBound(1.0, size, 1000000.0));
+}
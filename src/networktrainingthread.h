@@ -0,0 +1,96 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "network.h"
+#include "networksnapshot.h"
+
+//
+// Thread which trains a network outside of the GUI thread.
+//
+// The thread trains one sample at a time with the configured delay between samples and
+// publishes snapshots of the network state at most once per SnapshotInterval. In the
+// turbo mode there is no delay, samples are trained in batches sized to take about
+// TurboFrameBudget and a snapshot is published after every batch.
+//
+// A new snapshot is only published once the previous one has been consumed, so a slow
+// GUI never accumulates a backlog of snapshots.
+//
+// Every run of the training is identified by a generation number, results of a run
+// that has since been paused or stopped are ignored by the network.
+//
+class NetworkTrainingThread : public QThread
+{
+    Q_OBJECT
+public:
+    //
+    // Minimal number of milliseconds between two published snapshots
+    //
+    static constexpr int SnapshotInterval = 40;
+    //
+    // Number of milliseconds a batch of samples should take in the turbo mode
+    //
+    static constexpr int TurboFrameBudget = 16;
+
+    explicit NetworkTrainingThread(Network* network);
+    ~NetworkTrainingThread();
+
+    int resumeTraining();
+    void suspendTraining();
+    bool isCurrentGeneration(int generation);
+    void setSampleDelay(int delay);
+    void setTurbo(bool enabled);
+    void snapshotConsumed();
+
+signals:
+    void snapshotReady(int generation, const NetworkSnapshot& snapshot);
+    void trainingPaused(int generation);
+    void trainingStopped(int generation, Network::StopTrainingReason reason);
+
+protected:
+    void run() override;
+
+private:
+    void waitSampleDelay(int generation);
+    int adjustBatchSize(qint64 elapsed, int trained);
+
+    Network* m_network;
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    int m_generation = 0;
+    int m_sampleDelay = 1000;
+    bool m_turbo = false;
+    bool m_active = false;
+    bool m_quit = false;
+    QAtomicInt m_snapshotPending;
+
+    //
+    // Used only from the thread itself
+    //
+    double m_sampleCost = 0.0;
+    int m_batchSize = 1;
+};
@@ -41,6 +41,11 @@ NetworkViewWidget::NetworkViewWidget(Network* network, QWidget* parent) :
 
 NetworkViewWidget::~NetworkViewWidget()
 {
+    //
+    // The training thread must not outlive the network
+    //
+    if (m_network->isTraining() || m_network->isTrainingPaused())
+        m_network->stopTraining();
     delete ui;
 }
 
@@ -245,6 +250,20 @@ void NetworkViewWidget::on_sliderSampleDelay_valueChanged(int position)
     m_network->setTrainingSampleDelay(position);
 }
 
+void NetworkViewWidget::on_buttonTurbo_toggled(bool checked)
+{
+    //
+    // The sample delay is not used in the turbo mode
+    //
+    ui->sliderSampleDelay->setEnabled(!checked);
+    ui->buttonIntervalLeft->setEnabled(!checked);
+    ui->buttonIntervalSkipLeft->setEnabled(!checked);
+    ui->buttonIntervalRight->setEnabled(!checked);
+    ui->buttonIntervalSkipRight->setEnabled(!checked);
+
+    m_network->setTurboTraining(checked);
+}
+
 bool NetworkViewWidget::eventFilter(QObject* obj, QEvent* event)
 {
     if (event->type() == QEvent::Resize && obj == ui->diagram) {
@@ -83,6 +83,7 @@ private slots:
     void on_buttonIntervalRight_clicked();
     void on_buttonIntervalSkipRight_clicked();
     void on_sliderSampleDelay_valueChanged(int position);
+    void on_buttonTurbo_toggled(bool checked);
 
 protected:
     virtual bool eventFilter(QObject* obj, QEvent* event) override;
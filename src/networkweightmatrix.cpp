@@ -0,0 +1,75 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "networkweightmatrix.h"
+
+void NetworkWeightMatrix::resize(int rows, int columns, bool hasBias)
+{
+    Q_ASSERT(rows >= 0 && columns >= 0);
+
+    m_rows = rows;
+    m_columns = columns;
+    m_hasBias = hasBias;
+    m_weights.fill(0.0, rows * columns);
+    m_bias.fill(0.0, rows);
+}
+
+double NetworkWeightMatrix::connectionWeight(int row, int column) const
+{
+    if (column == BiasColumn) {
+        Q_ASSERT(m_hasBias);
+        return bias(row);
+    }
+    return weight(row, column);
+}
+
+void NetworkWeightMatrix::setConnectionWeight(int row, int column, double weight)
+{
+    if (column == BiasColumn) {
+        Q_ASSERT(m_hasBias);
+        setBias(row, weight);
+    } else
+        setWeight(row, column, weight);
+}
+
+void NetworkWeightMatrix::fill(double value)
+{
+    m_weights.fill(value);
+    if (m_hasBias)
+        m_bias.fill(value);
+}
+
+void NetworkSingleWeightMatrix::assign(const NetworkWeightMatrix& matrix)
+{
+    m_rows = matrix.rows();
+    m_columns = matrix.columns();
+    m_weights.resize(m_rows * m_columns);
+    m_bias.resize(m_rows);
+
+    if (m_rows == 0)
+        return;
+
+    const double* weights = matrix.rowData(0);
+    for (int i = 0; i < m_weights.size(); i++)
+        m_weights[i] = static_cast<float>(weights[i]);
+
+    const double* bias = matrix.biasData();
+    for (int i = 0; i < m_bias.size(); i++)
+        m_bias[i] = static_cast<float>(bias[i]);
+}
@@ -0,0 +1,107 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QVector>
+
+//
+// Dense storage of the input connection weights of a single layer.
+//
+// Row r holds the weights of the r-th non-bias neuron of the owning layer and column c
+// corresponds to the c-th non-bias neuron of the previous layer. Weights of connections
+// coming from the bias neuron of the previous layer are stored separately in the bias
+// vector, which is all zeros when the previous layer does not have a bias.
+//
+// The matrix is the authoritative copy of the weights, NetworkConnection objects only
+// display them.
+//
+class NetworkWeightMatrix
+{
+public:
+    //
+    // Column index used to address the bias weight of a row
+    //
+    static constexpr int BiasColumn = -1;
+
+    void resize(int rows, int columns, bool hasBias);
+
+    int rows() const { return m_rows; }
+    int columns() const { return m_columns; }
+    bool hasBias() const { return m_hasBias; }
+    bool isEmpty() const { return m_rows == 0; }
+
+    double weight(int row, int column) const {
+        return m_weights[row * m_columns + column];
+    }
+    void setWeight(int row, int column, double weight) {
+        m_weights[row * m_columns + column] = weight;
+    }
+
+    double bias(int row) const { return m_bias[row]; }
+    void setBias(int row, double bias) { m_bias[row] = bias; }
+
+    //
+    // Access a weight using the column numbering of connections, where BiasColumn
+    // refers to the bias weight
+    //
+    double connectionWeight(int row, int column) const;
+    void setConnectionWeight(int row, int column, double weight);
+
+    //
+    // Raw access for the computation kernels
+    //
+    double* rowData(int row) { return m_weights.data() + row * m_columns; }
+    const double* rowData(int row) const { return m_weights.constData() + row * m_columns; }
+    double* biasData() { return m_bias.data(); }
+    const double* biasData() const { return m_bias.constData(); }
+
+    void fill(double value);
+
+private:
+    int m_rows = 0;
+    int m_columns = 0;
+    bool m_hasBias = false;
+    QVector<double> m_weights;
+    QVector<double> m_bias;
+};
+
+//
+// Single-precision copy of a weight matrix used by the single-precision evaluation,
+// the copy is only refreshed on request by assign()
+//
+class NetworkSingleWeightMatrix
+{
+public:
+    void assign(const NetworkWeightMatrix& matrix);
+
+    int rows() const { return m_rows; }
+    int columns() const { return m_columns; }
+
+    const float* rowData(int row) const { return m_weights.constData() + row * m_columns; }
+    const float* biasData() const { return m_bias.constData(); }
+
+private:
+    int m_rows = 0;
+    int m_columns = 0;
+    QVector<float> m_weights;
+    QVector<float> m_bias;
+};
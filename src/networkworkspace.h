@@ -0,0 +1,62 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QVector>
+
+//
+// Scratch buffers used to compute the output of a network without allocating
+// memory for every sample.
+//
+// The values of the non-bias neurons of consecutive layers are computed into the
+// two buffers in turns, so each buffer only needs room for the widest layer, or
+// for the widest layer times the number of samples when computing a batch.
+//
+// Computing with a workspace does not modify the network, so several threads may
+// compute at the same time as long as every thread uses its own workspace.
+//
+struct NetworkWorkspace
+{
+    QVector<double> buffers[2];
+    QVector<float> singleBuffers[2];
+
+    //
+    // Return the buffer used for the given layer with room for at least 'size'
+    // values, the buffer only grows when it is too small
+    //
+    double* layerBuffer(int layer, int size) {
+        auto& buffer = buffers[layer % 2];
+        if (buffer.size() < size)
+            buffer.resize(size);
+        return buffer.data();
+    }
+
+    //
+    // Same as layerBuffer() for the single-precision computation
+    //
+    float* singleLayerBuffer(int layer, int size) {
+        auto& buffer = singleBuffers[layer % 2];
+        if (buffer.size() < size)
+            buffer.resize(size);
+        return buffer.data();
+    }
+};
@@ -0,0 +1,177 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "precisionbenchmark.h"
+
+#include <memory>
+#include <random>
+#include <QElapsedTimer>
+#include <QFileInfo>
+
+#include "adalinenetwork.h"
+#include "mlpnetwork.h"
+#include "rbfnetwork.h"
+#include "savednetwork.h"
+#include "slpnetwork.h"
+#include "xmlworker.h"
+
+PrecisionBenchmark::PrecisionBenchmark(QObject* parent) :
+    QObject(parent),
+    m_out(stdout)
+{
+}
+
+//
+// Examples used when no network files are given on the command line
+//
+QStringList PrecisionBenchmark::defaultFiles()
+{
+    return QStringList()
+            << ":/examples/adaline-clusters.xml"
+            << ":/examples/mlp-small-clusters.xml"
+            << ":/examples/rbf-iris.xml";
+}
+
+bool PrecisionBenchmark::run(const QStringList& filePaths)
+{
+    bool result = true;
+    for (const auto& filePath : filePaths) {
+        if (!runFile(filePath))
+            result = false;
+    }
+    return result;
+}
+
+bool PrecisionBenchmark::runFile(const QString& filePath)
+{
+    m_out << QFileInfo(filePath).fileName() << endl;
+
+    std::unique_ptr<SupervisedNetwork> network(createNetwork(filePath));
+    if (!network)
+        return false;
+    //
+    // Both precisions evaluate the same network with the same weights
+    //
+    Result results[2];
+    const NetworkInfo::EvaluationPrecision precisions[2] = {
+        NetworkInfo::EvaluationPrecision::Double,
+        NetworkInfo::EvaluationPrecision::Single
+    };
+    for (int i = 0; i < 2; i++) {
+        results[i] = measure(network.get(), precisions[i]);
+        printResult(NetworkInfo::evaluationPrecisionToString(precisions[i]), results[i]);
+    }
+    m_out << tr("  speedup %1x, error difference %2, correct difference %3%")
+             .arg(results[1].evaluationRate / results[0].evaluationRate, 0, 'f', 2)
+             .arg(results[1].error - results[0].error, 0, 'g', 6)
+             .arg(results[1].correctPercentage - results[0].correctPercentage, 0, 'f', 2)
+          << endl;
+    return true;
+}
+
+SupervisedNetwork* PrecisionBenchmark::createNetwork(const QString& filePath)
+{
+    SavedNetwork savedNetwork;
+    XmlWorker xml;
+    xml.setErrorOnUnknownNetwork(true);
+    if (!xml.readNetwork(filePath, savedNetwork, XmlWorker::ReadNetworkMode::ReadAll)) {
+        m_out << tr("  could not load the network: %1").arg(xml.error()) << endl;
+        return nullptr;
+    }
+
+    SupervisedNetwork* network = nullptr;
+    switch (NetworkInfo::typeFromMap(savedNetwork.infoMap())) {
+        case NetworkInfo::Type::SLP:
+            network = new SLPNetwork(savedNetwork);
+            break;
+        case NetworkInfo::Type::Adaline:
+            network = new AdalineNetwork(savedNetwork);
+            break;
+        case NetworkInfo::Type::MLP:
+            network = new MLPNetwork(savedNetwork);
+            break;
+        case NetworkInfo::Type::RBF:
+            network = new RBFNetwork(savedNetwork);
+            break;
+        case NetworkInfo::Type::Kohonen:
+        case NetworkInfo::Type::Unknown:
+            m_out << tr("  only supervised networks can be compared") << endl;
+            return nullptr;
+    }
+    if (!createSamples(network, savedNetwork.trainingSampleStore())) {
+        m_out << tr("  could not create the training samples: %1")
+                 .arg(network->trainingTableModel()->store().error())
+              << endl;
+        delete network;
+        return nullptr;
+    }
+    return network;
+}
+
+//
+// Repeat the samples of the file with a small noise added to their inputs, the
+// generator is seeded with a constant to get the same dataset every time
+//
+bool PrecisionBenchmark::createSamples(SupervisedNetwork* network, const TrainingSampleStore& source)
+{
+    if (source.samples().isEmpty())
+        return false;
+
+    std::mt19937 generator(Seed);
+    std::normal_distribution<double> noise(0.0, InputNoise * qMax(source.maxInput() - source.minInput(), 1.0));
+
+    TrainingSampleStore store(source.inputCount(), source.outputCount());
+    store.beginChange();
+    for (int i = 0; i < SampleCount; i++) {
+        TrainingSample sample = source.sample(i % source.samples().size());
+        for (int j = 0; j < source.inputCount(); j++)
+            sample.setInput(j, sample.input(j) + noise(generator));
+        store.addSample(std::move(sample));
+    }
+    store.endChange();
+
+    return network->trainingTableModel()->replaceSamples(std::move(store));
+}
+
+PrecisionBenchmark::Result PrecisionBenchmark::measure(SupervisedNetwork* network,
+                                                       NetworkInfo::EvaluationPrecision precision)
+{
+    Result result;
+    QElapsedTimer timer;
+
+    network->setEvaluationPrecision(precision);
+    timer.start();
+    for (int i = 0; i < EvaluationRepeats; i++)
+        network->evaluate();
+    result.evaluationRate = EvaluationRepeats * SampleCount * 1e9 / qMax(timer.nsecsElapsed(), qint64(1));
+
+    result.error = network->error();
+    result.correctPercentage = network->correctPercentage();
+    return result;
+}
+
+void PrecisionBenchmark::printResult(const QString& name, const Result& result)
+{
+    m_out << tr("  %1: %2 samples/s, error %3, %4% correct")
+             .arg(name, -6)
+             .arg(result.evaluationRate, 0, 'f', 0)
+             .arg(result.error, 0, 'g', 10)
+             .arg(result.correctPercentage, 0, 'f', 2)
+          << endl;
+}
@@ -0,0 +1,77 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+#include <QObject>
+#include <QStringList>
+#include <QTextStream>
+
+#include "networkinfo.h"
+#include "supervisednetwork.h"
+#include "trainingsamplestore.h"
+
+//
+// Command line benchmark comparing the double and single evaluation precision.
+//
+// The training samples of every network file are expanded into a larger fixed
+// dataset, which is evaluated repeatedly in both precisions with the weights
+// stored in the file. The training always runs in double precision, so only
+// the throughput of the evaluation and the difference of its results are
+// compared.
+//
+class PrecisionBenchmark : public QObject
+{
+    Q_OBJECT
+public:
+    //
+    // Size of the dataset and the number of its evaluations in every precision
+    //
+    static constexpr int SampleCount = 20000;
+    static constexpr int EvaluationRepeats = 20;
+    //
+    // Standard deviation of the noise added to the inputs of the repeated
+    // samples, relative to the range of the inputs
+    //
+    static constexpr double InputNoise = 0.02;
+    static constexpr unsigned int Seed = 1;
+
+    explicit PrecisionBenchmark(QObject* parent = nullptr);
+
+    static QStringList defaultFiles();
+
+    bool run(const QStringList& filePaths);
+
+private:
+    struct Result {
+        double evaluationRate = 0.0;
+        double error = 0.0;
+        double correctPercentage = 0.0;
+    };
+
+    bool runFile(const QString& filePath);
+    SupervisedNetwork* createNetwork(const QString& filePath);
+    bool createSamples(SupervisedNetwork* network, const TrainingSampleStore& source);
+    Result measure(SupervisedNetwork* network, NetworkInfo::EvaluationPrecision precision);
+    void printResult(const QString& name, const Result& result);
+
+    QTextStream m_out;
+};
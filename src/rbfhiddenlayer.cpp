@@ -19,9 +19,13 @@
  */
 #include "rbfhiddenlayer.h"
 
+#include <cmath>
+#include <cstring>
+
 #include "kmeansclustering.h"
 #include "rbfbiasneuron.h"
 #include "rbfhiddenneuron.h"
+#include "vectorkernels.h"
 
 RBFHiddenLayer::RBFHiddenLayer(int neurons, Network *parent) :
     RBFLayer(NetworkLayerInfo::Type::Hidden, parent)
@@ -31,8 +35,12 @@ RBFHiddenLayer::RBFHiddenLayer(int neurons, Network *parent) :
 
     addNeuron(new RBFBiasNeuron(this));
 
-    for (int i = 0; i < neurons; i++)
-        addNeuron(new RBFHiddenNeuron(this), true);
+    for (int i = 0; i < neurons; i++) {
+        auto* neuron = new RBFHiddenNeuron(this);
+
+        m_hiddenNeurons.append(neuron);
+        addNeuron(neuron, true);
+    }
 }
 
 RBFHiddenLayer::RBFHiddenLayer(SavedNetworkLayer* layer, Network* parent) :
@@ -41,13 +49,25 @@ RBFHiddenLayer::RBFHiddenLayer(SavedNetworkLayer* layer, Network* parent) :
     init();
     addNeuron(new RBFBiasNeuron(this));
 
-    for (auto* savedNeuron : layer->savedNeurons())
-        addNeuron(new RBFHiddenNeuron(savedNeuron, this));
+    for (auto* savedNeuron : layer->savedNeurons()) {
+        auto* neuron = new RBFHiddenNeuron(savedNeuron, this);
+
+        m_hiddenNeurons.append(neuron);
+        addNeuron(neuron);
+    }
 }
 
 void RBFHiddenLayer::init()
 {
     m_kmeans = new KMeansClustering(this);
+
+    connect(m_kmeans, &KMeansClustering::progress, this,
+            [this](int iteration, int changed, double inertia) {
+        emit statusMessage(tr("Clustering: iteration %1, %2 samples changed, inertia %3")
+                           .arg(iteration)
+                           .arg(changed)
+                           .arg(inertia));
+    });
 }
 
 bool RBFHiddenLayer::isTrained() const
@@ -68,6 +88,50 @@ const KMeansClustering& RBFHiddenLayer::kmeans() const
     return *m_kmeans;
 }
 
+//
+// Compute the gaussian response of each neuron to the input vector
+//
+void RBFHiddenLayer::computeInto(const double* input, double* output) const
+{
+    const int columns = m_inWeights.columns();
+
+    for (int row = 0; row < m_inWeights.rows(); row++) {
+        const double* weights = m_inWeights.rowData(row);
+        const double distance = VectorKernels::squaredDistance(input, weights, columns);
+
+        output[row] = std::exp(-m_hiddenNeurons.at(row)->beta() * distance);
+    }
+}
+
+//
+// Compute the gaussian responses for a batch of samples stored as rows of the input
+//
+void RBFHiddenLayer::computeBatchInto(const double* input, int count, double* output) const
+{
+    const int rows = m_inWeights.rows();
+
+    VectorKernels::squaredDistances(input, count, m_inWeights.rowData(0), rows,
+                                    m_inWeights.columns(), output);
+    for (int row = 0; row < rows; row++) {
+        const double beta = m_hiddenNeurons.at(row)->beta();
+        for (int i = 0; i < count; i++)
+            output[i * rows + row] = std::exp(-beta * output[i * rows + row]);
+    }
+}
+
+void RBFHiddenLayer::computeBatchInto(const float* input, int count, float* output) const
+{
+    const int rows = m_singleInWeights.rows();
+
+    VectorKernels::squaredDistances(input, count, m_singleInWeights.rowData(0), rows,
+                                    m_singleInWeights.columns(), output);
+    for (int row = 0; row < rows; row++) {
+        const float beta = static_cast<float>(m_hiddenNeurons.at(row)->beta());
+        for (int i = 0; i < count; i++)
+            output[i * rows + row] = std::exp(-beta * output[i * rows + row]);
+    }
+}
+
 int RBFHiddenLayer::clusterIndexToNeuronIndex(int clusterIndex) const
 {
     // Clusters are indexed from 0 and non-bias neurons from 1
@@ -81,10 +145,27 @@ int RBFHiddenLayer::neuronIndexToClusterIndex(int neuronIndex) const
     return neuronIndex - 1;
 }
 
-void RBFHiddenLayer::train(const QVector<TrainingSample>& samples)
+//
+// Place the centers of the neurons by clustering the samples, this is called from
+// the training thread and does not change the layer until train() is called.
+//
+// Returns false if the clustering was cancelled.
+//
+bool RBFHiddenLayer::cluster(const QVector<TrainingSample>& samples,
+                             const KMeansClustering::Options& options,
+                             const std::function<bool()>& cancelled)
 {
     m_kmeans->setTrainingSamples(samples);
-    m_kmeans->doClustering(neuronCount(true));
+
+    return m_kmeans->doClustering(neuronCount(true), options, cancelled);
+}
+
+//
+// Move the neurons to the centers found by cluster()
+//
+void RBFHiddenLayer::train()
+{
+    clearActivationCache();
 
     const auto& clusters = m_kmeans->clusters();
     QMap<int, double> clusterDistance;
@@ -100,10 +181,12 @@ void RBFHiddenLayer::train(const QVector<TrainingSample>& samples)
         double closest = m_kmeans->findClosestClusterDistance(clusterIndex);
         rbfNeuron->setSigma(closest);
 
-        for (int j = 0; j < rbfNeuron->inConnectionCount(); j++)
-            rbfNeuron->inConnection(j)->setWeight(clusters.at(clusterIndex).at(j));
+        const auto& cluster = clusters.at(clusterIndex);
+        double* weights = m_inWeights.rowData(clusterIndex);
+        for (int j = 0; j < m_inWeights.columns(); j++)
+            weights[j] = cluster.at(j);
     }
-    updateInConnectionRange();
+    syncInConnectionWeights();
     m_trained = true;
     emit trained();
 }
@@ -116,6 +199,67 @@ void RBFHiddenLayer::train(const QVector<TrainingSample>& samples)
 //
 void RBFHiddenLayer::untrain()
 {
+    clearActivationCache();
     m_trained = false;
     emit untrained();
 }
+
+//
+// Compute the activations for all training samples at once, they are then
+// reused in every epoch by forwardCached() instead of computing them again.
+//
+// The cache must be created again whenever the layer changes.
+//
+void RBFHiddenLayer::cacheActivations(const QVector<TrainingSample>& samples)
+{
+    const int rows = m_inWeights.rows();
+    const int columns = m_inWeights.columns();
+    const int count = samples.size();
+
+    clearActivationCache();
+    if (count == 0 || static_cast<qint64>(count) * rows > MaxCachedActivations)
+        return;
+
+    QVector<double> inputs(count * columns);
+    for (int i = 0; i < count; i++) {
+        const auto& sampleInputs = samples.at(i).inputs();
+        Q_ASSERT(sampleInputs.size() == columns);
+        std::memcpy(inputs.data() + i * columns, sampleInputs.constData(), columns * sizeof(double));
+    }
+    m_cachedActivations.resize(count * rows);
+    computeBatchInto(inputs.constData(), count, m_cachedActivations.data());
+    m_cachedSampleCount = count;
+}
+
+//
+// Set the activations of the training sample with the given index from the cache,
+// returns false if they are not cached and forward() must be used instead
+//
+bool RBFHiddenLayer::forwardCached(int sampleIndex)
+{
+    if (sampleIndex < 0 || sampleIndex >= m_cachedSampleCount)
+        return false;
+
+    std::memcpy(m_activations.data(), cachedActivations(sampleIndex),
+                m_activations.size() * sizeof(double));
+    syncNeuronValues();
+    return true;
+}
+
+//
+// Return the cached activations of the training sample with the given index, or
+// nullptr if they are not cached
+//
+const double* RBFHiddenLayer::cachedActivations(int sampleIndex) const
+{
+    if (sampleIndex < 0 || sampleIndex >= m_cachedSampleCount)
+        return nullptr;
+
+    return m_cachedActivations.constData() + sampleIndex * m_activations.size();
+}
+
+void RBFHiddenLayer::clearActivationCache()
+{
+    m_cachedActivations.clear();
+    m_cachedSampleCount = 0;
+}
@@ -21,7 +21,10 @@
 
 #include "common.h"
 
+#include <functional>
+
 #include "kmeansclustering.h"
+#include "rbfhiddenneuron.h"
 #include "rbflayer.h"
 #include "savednetworklayer.h"
 
@@ -32,9 +35,17 @@ public:
     RBFHiddenLayer(int neurons, Network *parent);
     RBFHiddenLayer(SavedNetworkLayer* layer, Network* parent);
 
+    void computeInto(const double* input, double* output) const override;
+    void computeBatchInto(const double* input, int count, double* output) const override;
+    void computeBatchInto(const float* input, int count, float* output) const override;
     bool isTrained() const;
-    void train(const QVector<TrainingSample>& samples);
+    bool cluster(const QVector<TrainingSample>& samples, const KMeansClustering::Options& options,
+                 const std::function<bool()>& cancelled);
+    void train();
     void untrain();
+    void cacheActivations(const QVector<TrainingSample>& samples);
+    bool forwardCached(int sampleIndex);
+    const double* cachedActivations(int sampleIndex) const;
     const KMeansClustering& kmeans() const;
 
     int clusterIndexToNeuronIndex(int clusterIndex) const;
@@ -48,8 +59,22 @@ protected:
     QString defaultNeuronName(int index) const override;
 
 private:
+    //
+    // Largest number of cached activations, the cache is not created for larger
+    // training sets
+    //
+    static constexpr int MaxCachedActivations = 1 << 25;
+
     void init();
+    void clearActivationCache();
 
     bool m_trained = false;
+    //
+    // Activations of the neurons for every training sample stored as the rows of
+    // a flat row-major array, valid while the layer does not change
+    //
+    QVector<double> m_cachedActivations;
+    int m_cachedSampleCount = 0;
     KMeansClustering* m_kmeans;
+    QVector<RBFHiddenNeuron*> m_hiddenNeurons;
 };
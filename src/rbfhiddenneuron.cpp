@@ -19,8 +19,6 @@
  */
 #include "rbfhiddenneuron.h"
 
-#include <cmath>
-
 #include "colors.h"
 
 RBFHiddenNeuron::RBFHiddenNeuron(NetworkLayer *parent) :
@@ -35,35 +33,6 @@ RBFHiddenNeuron::RBFHiddenNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer*
     setSigma(m_infoMap[NetworkNeuronInfo::Key::Sigma].toDouble());
 }
 
-//
-// Compute and return the output value of the neuron for the given input
-//
-double RBFHiddenNeuron::compute(const QVector<double>& input) const
-{
-    double value = 0.0;
-    for (int i = 0; i < input.size(); i++) {
-        double diff = input.at(i) - inConnection(i)->weight();
-        value += diff * diff;
-    }
-    return std::exp(-m_beta * value);
-}
-
-//
-// Compute and set the output value of the neuron for the currently set input values
-// in the previous layer
-//
-void RBFHiddenNeuron::forward()
-{
-    double value = 0.0;
-    const auto& connections = inConnections();
-    for (const auto* conn : connections) {
-        double diff = conn->neuron1()->value() - conn->weight();
-        value += diff * diff;
-    }
-    value = std::exp(-m_beta * value);
-    setValue(value);
-}
-
 void RBFHiddenNeuron::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
     QColor color;
@@ -32,10 +32,9 @@ public:
     explicit RBFHiddenNeuron(NetworkLayer* parent);
     explicit RBFHiddenNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent);
 
-    double compute(const QVector<double>& input) const override;
-    void forward() override;
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
 
+    double beta() const { return m_beta; }
     double sigma() const;
     void setSigma(double sigma);
 
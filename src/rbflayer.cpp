@@ -19,8 +19,6 @@
  */
 #include "rbflayer.h"
 
-#include "rbfneuron.h"
-
 RBFLayer::RBFLayer(NetworkLayerInfo::Type type, Network* parent) :
     SLPLayer(type, parent)
 {
@@ -33,16 +31,10 @@ RBFLayer::RBFLayer(const NetworkLayerInfo::Map& map, Network* parent) :
 
 QVector<double> RBFLayer::compute(const QVector<double>& input) const
 {
-    QVector<double> output;
-
-    const auto neuronItems = neurons();
-    for (auto* neuron : neuronItems) {
-        auto* rbfNeuron = qobject_cast<RBFNeuron*>(neuron);
+    Q_ASSERT(input.size() == m_inWeights.columns());
 
-        // Skip the bias unit
-        if (rbfNeuron != nullptr)
-            output.append(rbfNeuron->compute(input));
-    }
+    QVector<double> output(m_inWeights.rows());
+    computeInto(input.constData(), output.data());
     return output;
 }
 
@@ -51,12 +43,9 @@ QVector<double> RBFLayer::compute(const QVector<double>& input) const
 //
 void RBFLayer::forward()
 {
-    const auto neuronItems = neurons();
-    for (auto* neuron : neuronItems) {
-        auto* rbfNeuron = qobject_cast<RBFNeuron*>(neuron);
+    const auto* layer = previousLayer();
+    Q_ASSERT(layer != nullptr);
 
-        // Skip the bias unit
-        if (rbfNeuron != nullptr)
-            rbfNeuron->forward();
-    }
+    computeInto(layer->activations().constData(), m_activations.data());
+    syncNeuronValues();
 }
@@ -30,6 +30,9 @@ public:
     RBFLayer(NetworkLayerInfo::Type type, Network* parent);
     RBFLayer(const NetworkLayerInfo::Map& map, Network* parent);
 
-    QVector<double> compute(const QVector<double>& input) const;
+    QVector<double> compute(const QVector<double>& input) const override;
+    virtual void computeInto(const double* input, double* output) const = 0;
+    virtual void computeBatchInto(const double* input, int count, double* output) const = 0;
+    virtual void computeBatchInto(const float* input, int count, float* output) const = 0;
     virtual void forward();
 };
@@ -19,7 +19,10 @@
  */
 #include "rbfnetwork.h"
 
+#include <QMutexLocker>
+
 #include "graphicsutilities.h"
+#include "leastsquares.h"
 #include "rbfhiddenlayer.h"
 #include "rbfinputlayer.h"
 #include "rbfoutputlayer.h"
@@ -48,6 +51,7 @@ RBFNetwork::RBFNetwork(const NetworkInfo::Map& map, QObject* parent) :
     int outputCount = m_infoMap.value(NetworkInfo::Key::OutputNeuronCount).toInt();
     m_outputLayer = new RBFOutputLayer(outputCount, this);
     m_outputLayer->setLearningRate(learningRate());
+    m_outputLayer->setOptimizer(optimizer());
     addLayer(m_outputLayer);
 
     m_hiddenLayer->connectTo(m_outputLayer);
@@ -75,6 +79,7 @@ RBFNetwork::RBFNetwork(const SavedNetwork& savedNetwork, QObject* parent) :
 
     m_outputLayer = new RBFOutputLayer(savedLayers.at(2), this);
     m_outputLayer->setLearningRate(learningRate());
+    m_outputLayer->setOptimizer(optimizer());
     addLayer(m_outputLayer);
 
     m_hiddenLayer->connectTo(m_outputLayer);
@@ -86,23 +91,44 @@ void RBFNetwork::init()
 {
     if (m_infoMap.contains(NetworkInfo::Key::StopSamples))
         m_trainRBFLayer = m_infoMap[NetworkInfo::Key::StopSamples].toBool();
+    if (m_infoMap.contains(NetworkInfo::Key::ClusteringRestarts))
+        m_clusteringRestarts = qMax(1, m_infoMap[NetworkInfo::Key::ClusteringRestarts].toInt());
 
     const auto& store = trainingTableModel()->store();
     connect(&store, &TrainingSampleStore::samplesChanged, this, [this] {
         //
         // Mark the hidden layer as untrained when it no longer matches the
-        // training samples
+        // training samples, this drops the cached activations as well. The
+        // clustering of the previous samples must not be used either.
         //
+        QMutexLocker locker(&trainingMutex());
         m_hiddenLayer->untrain();
+        invalidatePrecomputation();
     });
 
     connect(this, &Network::infoChanged, this, [this] {
+        QMutexLocker locker(&trainingMutex());
         m_outputLayer->setLearningRate(learningRate());
+        m_outputLayer->setOptimizer(optimizer());
     });
 }
 
+KMeansClustering::Options RBFNetwork::clusteringOptions() const
+{
+    KMeansClustering::Options options;
+
+    options.method = clusteringMethod();
+    options.batchSize = clusteringBatchSize();
+    options.tolerance = clusteringTolerance();
+    options.epsilon = clusteringEpsilon();
+    options.restarts = m_clusteringRestarts;
+    return options;
+}
+
 void RBFNetwork::setTrainRBFLayer(bool trainRBFLayer)
 {
+    QMutexLocker locker(&trainingMutex());
+
     if (m_trainRBFLayer != trainRBFLayer) {
         m_trainRBFLayer = trainRBFLayer;
         m_infoMap[NetworkInfo::Key::TrainRBFLayer] = trainRBFLayer;
@@ -110,12 +136,130 @@ void RBFNetwork::setTrainRBFLayer(bool trainRBFLayer)
     }
 }
 
-QVector<double> RBFNetwork::compute(const QVector<double>& input) const
+int RBFNetwork::clusteringRestarts() const
+{
+    return m_clusteringRestarts;
+}
+
+//
+// Set the number of k-means runs placing the RBF centers, the best of them is kept
+//
+void RBFNetwork::setClusteringRestarts(int restarts)
+{
+    Q_ASSERT(restarts > 0);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (m_clusteringRestarts != restarts) {
+        m_clusteringRestarts = restarts;
+        if (restarts > 1)
+            m_infoMap[NetworkInfo::Key::ClusteringRestarts] = restarts;
+        else
+            m_infoMap.remove(NetworkInfo::Key::ClusteringRestarts);
+        emit infoChanged();
+    }
+}
+
+NetworkInfo::ClusteringMethod RBFNetwork::clusteringMethod() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::ClusteringMethod))
+        return NetworkInfo::clusteringMethodFromMap(m_infoMap);
+
+    return NetworkInfo::ClusteringMethod::Full;
+}
+
+void RBFNetwork::setClusteringMethod(NetworkInfo::ClusteringMethod method)
+{
+    Q_ASSERT(method != NetworkInfo::ClusteringMethod::Unknown);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (method != clusteringMethod()) {
+        m_infoMap[NetworkInfo::Key::ClusteringMethod] = QVariant::fromValue(method);
+        emit infoChanged();
+    }
+}
+
+int RBFNetwork::clusteringBatchSize() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::ClusteringBatchSize))
+        return qMax(1, m_infoMap[NetworkInfo::Key::ClusteringBatchSize].toInt());
+
+    return KMeansClustering::DefaultBatchSize;
+}
+
+void RBFNetwork::setClusteringBatchSize(int batchSize)
+{
+    Q_ASSERT(batchSize > 0);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (batchSize != clusteringBatchSize()) {
+        m_infoMap[NetworkInfo::Key::ClusteringBatchSize] = batchSize;
+        emit infoChanged();
+    }
+}
+
+double RBFNetwork::clusteringTolerance() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::ClusteringTolerance))
+        return m_infoMap[NetworkInfo::Key::ClusteringTolerance].toDouble();
+
+    return KMeansClustering::DefaultTolerance;
+}
+
+void RBFNetwork::setClusteringTolerance(double tolerance)
+{
+    QMutexLocker locker(&trainingMutex());
+
+    if (!qFuzzyCompare(tolerance, clusteringTolerance())) {
+        m_infoMap[NetworkInfo::Key::ClusteringTolerance] = tolerance;
+        emit infoChanged();
+    }
+}
+
+double RBFNetwork::clusteringEpsilon() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::ClusteringEpsilon))
+        return m_infoMap[NetworkInfo::Key::ClusteringEpsilon].toDouble();
+
+    return KMeansClustering::DefaultEpsilon;
+}
+
+void RBFNetwork::setClusteringEpsilon(double epsilon)
+{
+    QMutexLocker locker(&trainingMutex());
+
+    if (!qFuzzyCompare(epsilon, clusteringEpsilon())) {
+        m_infoMap[NetworkInfo::Key::ClusteringEpsilon] = epsilon;
+        emit infoChanged();
+    }
+}
+
+void RBFNetwork::compute(const double* input, double* output, NetworkWorkspace& workspace) const
+{
+    double* hidden = workspace.layerBuffer(1, m_hiddenLayer->activations().size());
+
+    m_hiddenLayer->computeInto(input, hidden);
+    m_outputLayer->computeInto(hidden, output);
+}
+
+void RBFNetwork::computeBatch(const double* inputs, int count, double* outputs,
+                              NetworkWorkspace& workspace) const
+{
+    double* hidden = workspace.layerBuffer(1, count * m_hiddenLayer->activations().size());
+
+    m_hiddenLayer->computeBatchInto(inputs, count, hidden);
+    m_outputLayer->computeBatchInto(hidden, count, outputs);
+}
+
+void RBFNetwork::computeBatch(const float* inputs, int count, float* outputs,
+                              NetworkWorkspace& workspace) const
 {
-    auto vector = input;
-    vector = m_hiddenLayer->compute(vector);
-    vector = m_outputLayer->compute(vector);
-    return vector;
+    float* hidden = workspace.singleLayerBuffer(1, count * m_hiddenLayer->activations().size());
+
+    m_hiddenLayer->computeBatchInto(inputs, count, hidden);
+    m_outputLayer->computeBatchInto(hidden, count, outputs);
 }
 
 void RBFNetwork::computeAndSet(const QVector<double>& input)
@@ -125,22 +269,98 @@ void RBFNetwork::computeAndSet(const QVector<double>& input)
     m_outputLayer->forward();
 }
 
+//
+// Cluster the samples for the RBF layer without blocking the GUI, the clustering
+// is cancelled when the training is paused or stopped or when the samples change.
+//
+// The samples and the options are copied at once, so that the clustering is not
+// affected by the changes made in the GUI while it runs.
+//
+bool RBFNetwork::precomputeTraining()
+{
+    m_clustered = false;
+
+    QVector<TrainingSample> samples;
+    KMeansClustering::Options options;
+    {
+        QMutexLocker locker(&trainingMutex());
+        if (!m_trainRBFLayer)
+            return true;
+        samples = trainingTableModel()->store().samples();
+        options = clusteringOptions();
+    }
+    qDebug() << "Clustering the RBF layer";
+    m_clustered = m_hiddenLayer->cluster(samples, options, [this] {
+        return isTrainingCancelled();
+    });
+    return m_clustered;
+}
+
 void RBFNetwork::prepareTraining()
 {
-    if (!m_trainRBFLayer)
-        return;
+    m_outputLayer->resetOptimizer();
+    if (m_clustered) {
+        qDebug() << "Training the RBF layer";
+        m_hiddenLayer->train();
+        m_clustered = false;
+        m_outputLayer->resetRange();
+        if (pauseAfterSample())
+            requestTrainingPause();
+    }
+    //
+    // The hidden layer does not change while the output layer is trained, so its
+    // activations are computed once for the whole training set
+    //
+    m_hiddenLayer->cacheActivations(trainingTableModel()->store().samples());
 
-    qDebug() << "Training the RBF layer";
-    m_hiddenLayer->train(trainingTableModel()->store().samples());
-    m_outputLayer->resetRange();
-    if (pauseAfterSample())
-        pauseTraining();
+    if (trainingMethod() == NetworkInfo::TrainingMethod::Solve)
+        solveOutputWeights();
+}
+
+//
+// Compute the output weights with the least squares error over the training set
+// at once and stop the training
+//
+void RBFNetwork::solveOutputWeights()
+{
+    const auto& samples = trainingTableModel()->store().samples();
+    const auto& weights = m_outputLayer->inWeights();
+    LeastSquares equations(weights.columns(), weights.rows());
+
+    QVector<double> activations(weights.columns());
+    for (int i = 0; i < samples.size(); i++) {
+        const auto& sample = samples.at(i);
+        const double* input = m_hiddenLayer->cachedActivations(i);
+        if (input == nullptr) {
+            m_hiddenLayer->computeInto(sample.inputs().constData(), activations.data());
+            input = activations.constData();
+        }
+        equations.addSample(input, sample.outputs().constData());
+    }
+
+    if (m_outputLayer->solveWeights(equations, ridgeRegularization()))
+        requestTrainingStop(StopTrainingReason::WeightsSolved);
+    else {
+        emit statusMessage(tr("The output weights cannot be solved"));
+        requestTrainingStop(StopTrainingReason::UserRequested);
+    }
 }
 
 void RBFNetwork::train(const TrainingSample& sample)
+{
+    train(sample, -1);
+}
+
+//
+// Train with a sample of the training set, its index there selects the cached
+// activations of the hidden layer, which are computed when the index is not
+// valid
+//
+void RBFNetwork::train(const TrainingSample& sample, int sampleIndex)
 {
     m_inputLayer->setValues(sample.inputs());
-    m_hiddenLayer->forward();
+    if (!m_hiddenLayer->forwardCached(sampleIndex))
+        m_hiddenLayer->forward();
     m_outputLayer->forward();
     m_outputLayer->updateWeights(sample.outputs());
 }
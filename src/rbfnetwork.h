@@ -34,19 +34,41 @@ public:
     explicit RBFNetwork(const NetworkInfo::Map& map, QObject* parent = nullptr);
     explicit RBFNetwork(const SavedNetwork& savedNetwork, QObject* parent = nullptr);
 
-    QVector<double> compute(const QVector<double>& input) const override;
+    using Network::compute;
+    using Network::computeBatch;
+    void compute(const double* input, double* output, NetworkWorkspace& workspace) const override;
+    void computeBatch(const double* inputs, int count, double* outputs,
+                      NetworkWorkspace& workspace) const override;
+    void computeBatch(const float* inputs, int count, float* outputs,
+                      NetworkWorkspace& workspace) const override;
     void computeAndSet(const QVector<double>& input) override;
     void train(const TrainingSample& sample) override;
+    void train(const TrainingSample& sample, int sampleIndex) override;
     void setTrainRBFLayer(bool trainRBFLayer);
+    int clusteringRestarts() const;
+    void setClusteringRestarts(int restarts);
+    NetworkInfo::ClusteringMethod clusteringMethod() const;
+    void setClusteringMethod(NetworkInfo::ClusteringMethod method);
+    int clusteringBatchSize() const;
+    void setClusteringBatchSize(int batchSize);
+    double clusteringTolerance() const;
+    void setClusteringTolerance(double tolerance);
+    double clusteringEpsilon() const;
+    void setClusteringEpsilon(double epsilon);
     void updateScenePosition() override;
 
 protected:
+    bool precomputeTraining() override;
     void prepareTraining() override;
 
 private:
     void init();
+    void solveOutputWeights();
+    KMeansClustering::Options clusteringOptions() const;
 
     bool m_trainRBFLayer = true;
+    bool m_clustered = false;
+    int m_clusteringRestarts = 1;
     RBFInputLayer* m_inputLayer;
     RBFHiddenLayer* m_hiddenLayer;
     RBFOutputLayer* m_outputLayer;
@@ -28,13 +28,3 @@ RBFNeuron::RBFNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent) :
     SLPNeuron(savedNeuron, parent)
 {
 }
-
-double RBFNeuron::compute(const QVector<double>& input) const
-{
-    Q_UNUSED(input);
-    return 0.0;
-}
-
-void RBFNeuron::forward()
-{
-}
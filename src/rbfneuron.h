@@ -30,7 +30,4 @@ class RBFNeuron : public SLPNeuron
 public:
     RBFNeuron(NetworkLayer* parent);
     RBFNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent);
-
-    virtual double compute(const QVector<double>& input) const;
-    virtual void forward();
 };
@@ -20,6 +20,7 @@
 #include "rbfoutputlayer.h"
 
 #include "rbfoutputneuron.h"
+#include "vectorkernels.h"
 
 RBFOutputLayer::RBFOutputLayer(int neurons, Network *parent) :
     RBFLayer(NetworkLayerInfo::Type::Output, parent)
@@ -51,16 +52,61 @@ QString RBFOutputLayer::defaultNeuronName(int index) const
 }
 
 //
-// Forward values from the previous layer
+// Output is the linear combination of the RBF layer values
 //
-void RBFOutputLayer::forward()
+void RBFOutputLayer::computeInto(const double* input, double* output) const
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = rbfOutputNeuron(i);
+    const int columns = m_inWeights.columns();
+    const double* bias = m_inWeights.biasData();
+
+    for (int row = 0; row < m_inWeights.rows(); row++) {
+        const double* weights = m_inWeights.rowData(row);
+
+        double value = bias[row] + VectorKernels::dot(input, weights, columns);
+
+        output[row] = value;
+    }
+}
+
+//
+// Compute the output values for a batch of samples stored as rows of the input
+//
+void RBFOutputLayer::computeBatchInto(const double* input, int count, double* output) const
+{
+    const int rows = m_inWeights.rows();
+    const double* bias = m_inWeights.biasData();
+
+    VectorKernels::multiplyTransposed(input, count, m_inWeights.rowData(0), rows,
+                                      m_inWeights.columns(), output);
+    for (int i = 0; i < count; i++) {
+        double* values = output + i * rows;
+        for (int row = 0; row < rows; row++)
+            values[row] += bias[row];
+    }
+}
+
+void RBFOutputLayer::computeBatchInto(const float* input, int count, float* output) const
+{
+    const int rows = m_singleInWeights.rows();
+    const float* bias = m_singleInWeights.biasData();
+
+    VectorKernels::multiplyTransposed(input, count, m_singleInWeights.rowData(0), rows,
+                                      m_singleInWeights.columns(), output);
+    for (int i = 0; i < count; i++) {
+        float* values = output + i * rows;
+        for (int row = 0; row < rows; row++)
+            values[row] += bias[row];
+    }
+}
 
-        neuron->forward();
-        m_minValue = qMin(m_minValue, neuron->value());
-        m_maxValue = qMax(m_maxValue, neuron->value());
+//
+// Display the values and extend the range of values used to color the neurons
+//
+void RBFOutputLayer::applyNeuronValues(const QVector<double>& values)
+{
+    for (double value : values) {
+        m_minValue = qMin(m_minValue, value);
+        m_maxValue = qMax(m_maxValue, value);
     }
 
     for (int i = 0; i < neuronCount(); i++) {
@@ -68,6 +114,7 @@ void RBFOutputLayer::forward()
 
         neuron->setValueRange(m_minValue, m_maxValue);
     }
+    RBFLayer::applyNeuronValues(values);
 }
 
 bool RBFOutputLayer::inConnectionWeightsSettable() const
@@ -80,37 +127,47 @@ RBFOutputNeuron* RBFOutputLayer::rbfOutputNeuron(int index) const
     return qobject_cast<RBFOutputNeuron*>(neuron(index));
 }
 
+//
+// Forget the range of the displayed values, the neurons receive the new range
+// with the next displayed values
+//
 void RBFOutputLayer::resetRange()
 {
     m_minValue = qInf();
     m_maxValue = -qInf();
-
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* neuron = rbfOutputNeuron(i);
-
-        neuron->setValueRange(m_minValue, m_maxValue);
-    }
 }
 
 void RBFOutputLayer::setLearningRate(double learningRate)
 {
     Q_ASSERT(learningRate > 0.0 && learningRate <= 1.0);
 
-    const auto neuronItems = neurons();
-    for (auto* neuron : neuronItems) {
-        auto* rbfNeuron = qobject_cast<RBFOutputNeuron*>(neuron);
-        rbfNeuron->setLearningRate(learningRate);
-    }
+    m_optimizer.setLearningRate(learningRate);
+}
+
+void RBFOutputLayer::setOptimizer(NetworkInfo::Optimizer optimizer)
+{
+    m_optimizer.setType(optimizer);
+}
+
+void RBFOutputLayer::resetOptimizer()
+{
+    m_optimizer.reset();
 }
 
+//
+// Apply the delta rule to the output weights using the current values of both layers
+//
 void RBFOutputLayer::updateWeights(const QVector<double>& target)
 {
     Q_ASSERT(target.size() == neuronCount());
 
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* rbfNeuron = qobject_cast<RBFOutputNeuron*>(neuron(i));
+    const auto* layer = previousLayer();
+    Q_ASSERT(layer != nullptr);
 
-        rbfNeuron->updateWeights(target.at(i));
-    }
-    updateInConnectionRange();
+    const double* input = layer->activations().constData();
+
+    m_optimizer.beginUpdate(m_inWeights);
+    for (int row = 0; row < m_inWeights.rows(); row++)
+        m_optimizer.updateRow(m_inWeights, row, m_activations.at(row) - target.at(row), input);
+    syncInConnectionWeights();
 }
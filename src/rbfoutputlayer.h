@@ -21,6 +21,7 @@
 
 #include "common.h"
 
+#include "networkoptimizer.h"
 #include "rbflayer.h"
 #include "rbfoutputneuron.h"
 #include "savednetworklayer.h"
@@ -32,17 +33,23 @@ public:
     explicit RBFOutputLayer(int neurons, Network *parent = nullptr);
     explicit RBFOutputLayer(SavedNetworkLayer* layer, Network* parent = nullptr);
 
-    void forward() override;
+    void applyNeuronValues(const QVector<double>& values) override;
+    void computeInto(const double* input, double* output) const override;
+    void computeBatchInto(const double* input, int count, double* output) const override;
+    void computeBatchInto(const float* input, int count, float* output) const override;
     bool inConnectionWeightsSettable() const override;
     RBFOutputNeuron* rbfOutputNeuron(int index) const;
     void resetRange();
     void setLearningRate(double learningRate);
+    void setOptimizer(NetworkInfo::Optimizer optimizer);
+    void resetOptimizer();
     void updateWeights(const QVector<double>& target);
 
 protected:
     QString defaultNeuronName(int index) const override;
 
 private:
+    NetworkOptimizer m_optimizer;
     double m_minValue;
     double m_maxValue;
 };
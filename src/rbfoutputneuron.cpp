@@ -35,24 +35,6 @@ RBFOutputNeuron::RBFOutputNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer*
     m_maxValue = -qInf();
 }
 
-double RBFOutputNeuron::compute(const QVector<double>& input) const
-{
-    double value = inConnection(0)->weight();
-    for (int i = 1; i < input.size(); i++)
-        value += input.at(i - 1) * inConnection(i)->weight();
-
-    return value;
-}
-
-void RBFOutputNeuron::forward()
-{
-    double value = 0.0;
-    for (const auto* conn : inConnections())
-        value += conn->neuron1()->value() * conn->weight();
-
-    setValue(value);
-}
-
 void RBFOutputNeuron::resetValue()
 {
     m_minValue = qInf();
@@ -61,28 +43,12 @@ void RBFOutputNeuron::resetValue()
     NetworkNeuron::resetValue();
 }
 
-void RBFOutputNeuron::setLearningRate(double learningRate)
-{
-    m_learningRate = learningRate;
-}
-
 void RBFOutputNeuron::setValueRange(double min, double max)
 {
     m_minValue = min;
     m_maxValue = max;
 }
 
-void RBFOutputNeuron::updateWeights(double target)
-{
-    for (int i = 0; i < inConnectionCount(); i++) {
-        auto* conn = inConnection(i);
-
-        double weight = conn->weight() + m_learningRate * (target - value()) * conn->neuron1()->value();
-
-        conn->setWeight(weight);
-    }
-}
-
 void RBFOutputNeuron::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
     QColor color;
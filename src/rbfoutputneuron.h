@@ -32,17 +32,12 @@ public:
     RBFOutputNeuron(NetworkLayer* parent);
     RBFOutputNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent);
 
-    double compute(const QVector<double>& input) const override;
-    void forward() override;
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
     void resetValue() override;
-    void setLearningRate(double learningRate);
     void setValueRange(double min, double max);
-    void updateWeights(double target);
 
 private:
     QColor m_lastColor;
-    double m_learningRate = 1.0;
     double m_minValue;
     double m_maxValue;
 };
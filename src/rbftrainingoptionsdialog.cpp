@@ -38,8 +38,17 @@ void RBFTrainingOptionsDialog::init()
 {
     const auto& map = m_network->infoMap();
 
+    ui->comboBoxTrainingMethod->addItems(NetworkInfo::trainingMethodStringList());
+    ui->comboBoxTrainingMethod->setCurrentIndex(
+                NetworkInfo::trainingMethodToIndex(m_network->trainingMethod()));
+    on_comboBoxTrainingMethod_currentIndexChanged(ui->comboBoxTrainingMethod->currentIndex());
+    ui->editRidgeRegularization->setValue(m_network->ridgeRegularization());
+
     ui->editLearningRate->setValue(map[NetworkInfo::Key::LearningRate].toDouble());
 
+    ui->comboBoxOptimizer->addItems(NetworkInfo::optimizerStringList());
+    ui->comboBoxOptimizer->setCurrentIndex(NetworkInfo::optimizerToIndex(m_network->optimizer()));
+
     if (map.contains(NetworkInfo::Key::MaxEpochs)) {
         ui->checkBoxMaxEpochs->setChecked(true);
         ui->editMaxEpochs->setEnabled(true);
@@ -54,18 +63,41 @@ void RBFTrainingOptionsDialog::init()
         ui->checkBoxPauseAfterSample->setChecked(map[NetworkInfo::Key::PauseAfterSample].toBool());
     if (map.contains(NetworkInfo::Key::TrainRBFLayer))
         ui->checkBoxTrainRBFLayer->setChecked(map[NetworkInfo::Key::TrainRBFLayer].toBool());
+    ui->editClusteringRestarts->setValue(m_network->clusteringRestarts());
+    ui->editClusteringBatchSize->setValue(m_network->clusteringBatchSize());
+    ui->editClusteringTolerance->setValue(m_network->clusteringTolerance());
+    ui->editClusteringEpsilon->setValue(m_network->clusteringEpsilon());
 
     //
     // Populate the combo boxes
     //
+    ui->comboBoxClusteringMethod->addItems(NetworkInfo::clusteringMethodStringList());
+    ui->comboBoxClusteringMethod->setCurrentIndex(
+                NetworkInfo::clusteringMethodToIndex(m_network->clusteringMethod()));
+    on_comboBoxClusteringMethod_currentIndexChanged(ui->comboBoxClusteringMethod->currentIndex());
+
     ui->comboBoxSampleSelectionOrder->addItems(NetworkInfo::sampleSelectionOrderStringList());
     if (map.contains(NetworkInfo::Key::SampleSelectionOrder))
         ui->comboBoxSampleSelectionOrder->setCurrentIndex(NetworkInfo::sampleSelectionOrderIndexFromMap(map));
+
+    ui->comboBoxEvaluationMode->addItems(NetworkInfo::evaluationModeStringList());
+    ui->comboBoxEvaluationMode->setCurrentIndex(
+                NetworkInfo::evaluationModeToIndex(m_network->evaluationMode()));
+    ui->editEvaluationInterval->setValue(m_network->evaluationInterval());
+
+    ui->comboBoxEvaluationPrecision->addItems(NetworkInfo::evaluationPrecisionStringList());
+    ui->comboBoxEvaluationPrecision->setCurrentIndex(
+                NetworkInfo::evaluationPrecisionToIndex(m_network->evaluationPrecision()));
 }
 
 void RBFTrainingOptionsDialog::accept()
 {
+    m_network->setTrainingMethod(
+                NetworkInfo::trainingMethodFromIndex(
+                    ui->comboBoxTrainingMethod->currentIndex()));
+    m_network->setRidgeRegularization(ui->editRidgeRegularization->value());
     m_network->setLearningRate(ui->editLearningRate->value());
+    m_network->setOptimizer(NetworkInfo::optimizerFromIndex(ui->comboBoxOptimizer->currentIndex()));
 
     if (ui->checkBoxMaxEpochs->isChecked())
         m_network->setMaxTrainingEpochs(ui->editMaxEpochs->value());
@@ -74,11 +106,26 @@ void RBFTrainingOptionsDialog::accept()
 
     m_network->setPauseAfterSample(ui->checkBoxPauseAfterSample->isChecked());
     m_network->setTrainRBFLayer(ui->checkBoxTrainRBFLayer->isChecked());
+    m_network->setClusteringRestarts(ui->editClusteringRestarts->value());
+    m_network->setClusteringMethod(
+                NetworkInfo::clusteringMethodFromIndex(
+                    ui->comboBoxClusteringMethod->currentIndex()));
+    m_network->setClusteringBatchSize(ui->editClusteringBatchSize->value());
+    m_network->setClusteringTolerance(ui->editClusteringTolerance->value());
+    m_network->setClusteringEpsilon(ui->editClusteringEpsilon->value());
 
     m_network->setSampleSelectionOrder(
                 NetworkInfo::sampleSelectionOrderFromIndex(
                     ui->comboBoxSampleSelectionOrder->currentIndex()));
 
+    m_network->setEvaluationMode(
+                NetworkInfo::evaluationModeFromIndex(
+                    ui->comboBoxEvaluationMode->currentIndex()));
+    m_network->setEvaluationInterval(ui->editEvaluationInterval->value());
+    m_network->setEvaluationPrecision(
+                NetworkInfo::evaluationPrecisionFromIndex(
+                    ui->comboBoxEvaluationPrecision->currentIndex()));
+
     if (ui->checkBoxStopError->isChecked())
         m_network->setStopError(ui->editStopError->value());
     else
@@ -96,3 +143,37 @@ void RBFTrainingOptionsDialog::on_checkBoxStopError_clicked(bool checked)
 {
     ui->editStopError->setEnabled(checked);
 }
+
+void RBFTrainingOptionsDialog::on_comboBoxEvaluationMode_currentIndexChanged(int index)
+{
+    //
+    // The interval is only used by the interval evaluation mode
+    //
+    ui->editEvaluationInterval->setEnabled(
+                NetworkInfo::evaluationModeFromIndex(index) == NetworkInfo::EvaluationMode::Interval);
+}
+
+void RBFTrainingOptionsDialog::on_comboBoxClusteringMethod_currentIndexChanged(int index)
+{
+    //
+    // The remaining clustering options are only used by the mini-batch method
+    //
+    bool miniBatch = NetworkInfo::clusteringMethodFromIndex(index) == NetworkInfo::ClusteringMethod::MiniBatch;
+
+    ui->editClusteringBatchSize->setEnabled(miniBatch);
+    ui->editClusteringTolerance->setEnabled(miniBatch);
+    ui->editClusteringEpsilon->setEnabled(miniBatch);
+}
+
+void RBFTrainingOptionsDialog::on_comboBoxTrainingMethod_currentIndexChanged(int index)
+{
+    //
+    // The learning rate and the optimizer are only used by the least mean squares
+    // method and the regularization only by the solved weights
+    //
+    bool solve = NetworkInfo::trainingMethodFromIndex(index) == NetworkInfo::TrainingMethod::Solve;
+
+    ui->editLearningRate->setEnabled(!solve);
+    ui->comboBoxOptimizer->setEnabled(!solve);
+    ui->editRidgeRegularization->setEnabled(solve);
+}
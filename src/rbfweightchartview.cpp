@@ -98,7 +98,7 @@ void RBFWeightChartView::init()
             updateRange();
         }
     });
-    connect(m_network, &Network::neuronWeightChanged, this, [this] {
+    connect(m_network, &Network::weightsUpdated, this, [this] {
         //
         // Handle weight changes when the network is not being trained. This happens
         // when it's changed manually by the user and it should be reflected by
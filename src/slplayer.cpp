@@ -32,6 +32,19 @@ SLPLayer::SLPLayer(const NetworkLayerInfo::Map& map, Network* parent) :
 {
 }
 
+//
+// Replace the incoming weights by the least squares solution of the equations
+// built from the inputs of this layer, returns false if they cannot be solved
+//
+bool SLPLayer::solveWeights(const LeastSquares& equations, double ridge)
+{
+    if (!equations.solve(ridge, m_inWeights))
+        return false;
+
+    syncInConnectionWeights();
+    return true;
+}
+
 void SLPLayer::updateScenePosition(QRectF neuronBoundingRect)
 {
     if (neuronCount() == 0)
@@ -23,6 +23,7 @@
 
 #include <QRectF>
 
+#include "leastsquares.h"
 #include "savednetworklayer.h"
 #include "supervisedlayer.h"
 
@@ -34,5 +35,6 @@ public:
     explicit SLPLayer(const NetworkLayerInfo::Map& map, Network* parent = nullptr);
     explicit SLPLayer(const SavedNetworkLayer* layer, Network* parent = nullptr);
 
+    bool solveWeights(const LeastSquares& equations, double ridge);
     void updateScenePosition(QRectF neuronBoundingRect);
 };
@@ -20,6 +20,7 @@
 #include "slpnetwork.h"
 
 #include <cmath>
+#include <QMutexLocker>
 
 #include "graphicsutilities.h"
 
@@ -110,13 +111,29 @@ void SLPNetwork::init()
     });
 
     connect(this, &Network::infoChanged, this, [this] {
+        QMutexLocker locker(&trainingMutex());
         m_outputLayer->setLearningRate(learningRate());
     });
 }
 
-QVector<double> SLPNetwork::compute(const QVector<double>& input) const
+void SLPNetwork::compute(const double* input, double* output, NetworkWorkspace& workspace) const
 {
-    return m_outputLayer->compute(input);
+    Q_UNUSED(workspace);
+    m_outputLayer->computeInto(input, output);
+}
+
+void SLPNetwork::computeBatch(const double* inputs, int count, double* outputs,
+                              NetworkWorkspace& workspace) const
+{
+    Q_UNUSED(workspace);
+    m_outputLayer->computeBatchInto(inputs, count, outputs);
+}
+
+void SLPNetwork::computeBatch(const float* inputs, int count, float* outputs,
+                              NetworkWorkspace& workspace) const
+{
+    Q_UNUSED(workspace);
+    m_outputLayer->computeBatchInto(inputs, count, outputs);
 }
 
 void SLPNetwork::computeAndSet(const QVector<double>& input)
@@ -138,19 +155,26 @@ void SLPNetwork::train(const TrainingSample& sample)
 
 void SLPNetwork::updateCurrentStatus()
 {
-    m_correctSamples = 0;
-    const auto& samples = trainingTableModel()->store().samples();
-    for (const auto& sample : samples) {
-        auto outputs = compute(sample.inputs());
-        if (outputs == sample.outputs())
-            m_correctSamples++;
-    }
-    if (!samples.isEmpty())
-        m_correctPercentage = 100.0 * (m_correctSamples / static_cast<double>(samples.size()));
-    else
-        m_correctPercentage = 0.0;
-
-    m_error = samples.size() - m_correctSamples;
+    //
+    // The general implementation counts the correctly classified samples,
+    // the error of this network is the number of the other samples
+    //
+    SupervisedNetwork::updateCurrentStatus();
+
+    m_error = trainingTableModel()->store().samples().size() - m_correctSamples;
+}
+
+void SLPNetwork::updateMovingAverage(const QVector<double>& outputs,
+                                     const TrainingSample& sample,
+                                     double weight)
+{
+    double correct = (outputs == sample.outputs()) ? 100.0 : 0.0;
+    int sampleCount = trainingTableModel()->store().samples().size();
+
+    m_correctPercentage += weight * (correct - m_correctPercentage);
+    m_correctSamples = qRound(m_correctPercentage / 100.0 * sampleCount);
+
+    m_error = sampleCount - m_correctSamples;
 }
 
 void SLPNetwork::updateScenePosition()
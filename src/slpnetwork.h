@@ -36,7 +36,13 @@ public:
     explicit SLPNetwork(const NetworkInfo::Map& map, QObject* parent = nullptr);
     explicit SLPNetwork(const SavedNetwork& savedNetwork, QObject* parent = nullptr);
 
-    QVector<double> compute(const QVector<double>& input) const override;
+    using Network::compute;
+    using Network::computeBatch;
+    void compute(const double* input, double* output, NetworkWorkspace& workspace) const override;
+    void computeBatch(const double* inputs, int count, double* outputs,
+                      NetworkWorkspace& workspace) const override;
+    void computeBatch(const float* inputs, int count, float* outputs,
+                      NetworkWorkspace& workspace) const override;
     void computeAndSet(const QVector<double>& input) override;
 
     ErrorValueType errorValueType() override;
@@ -46,6 +52,9 @@ public:
 
 protected:
     void updateCurrentStatus() override;
+    void updateMovingAverage(const QVector<double>& outputs,
+                             const TrainingSample& sample,
+                             double weight) override;
 
 private:
     void init();
@@ -20,6 +20,7 @@
 #include "slpoutputlayer.h"
 
 #include "slpoutputneuron.h"
+#include "vectorkernels.h"
 
 SLPOutputLayer::SLPOutputLayer(Network* parent) :
     SLPLayer(NetworkLayerInfo::Type::Output, parent)
@@ -54,15 +55,10 @@ SLPOutputLayer::SLPOutputLayer(const SavedNetworkLayer* layer, Network* parent)
 //
 QVector<double> SLPOutputLayer::compute(const QVector<double>& input) const
 {
-    int size = neuronCount();
+    Q_ASSERT(input.size() == m_inWeights.columns());
 
-    QVector<double> output(size);
-    for (int i = 0; i < size; i++) {
-        auto* n = qobject_cast<SLPOutputNeuron*>(neuron(i));
-        Q_ASSERT(n != nullptr);
-
-        output[i] = n->compute(input);
-    }
+    QVector<double> output(m_inWeights.rows());
+    computeInto(input.constData(), output.data());
     return output;
 }
 
@@ -71,25 +67,92 @@ QVector<double> SLPOutputLayer::compute(const QVector<double>& input) const
 //
 void SLPOutputLayer::computeAndSet(const QVector<double>& input)
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* n = qobject_cast<SLPOutputNeuron*>(neuron(i));
-        Q_ASSERT(n != nullptr);
+    Q_ASSERT(input.size() == m_inWeights.columns());
+
+    computeInto(input.constData(), m_activations.data());
+    syncNeuronValues();
+}
+
+void SLPOutputLayer::computeInto(const double* input, double* output) const
+{
+    const int columns = m_inWeights.columns();
+    const double* bias = m_inWeights.biasData();
+
+    for (int row = 0; row < m_inWeights.rows(); row++) {
+        const double* weights = m_inWeights.rowData(row);
+
+        double value = bias[row] + VectorKernels::dot(input, weights, columns);
+
+        output[row] = activate(value);
+    }
+}
 
-        n->setValue(n->compute(input));
+//
+// Compute the output values for a batch of samples stored as rows of the input
+//
+void SLPOutputLayer::computeBatchInto(const double* input, int count, double* output) const
+{
+    const int rows = m_inWeights.rows();
+    const double* bias = m_inWeights.biasData();
+
+    VectorKernels::multiplyTransposed(input, count, m_inWeights.rowData(0), rows,
+                                      m_inWeights.columns(), output);
+    for (int i = 0; i < count; i++) {
+        double* values = output + i * rows;
+        for (int row = 0; row < rows; row++)
+            values[row] = activate(values[row] + bias[row]);
     }
 }
 
+//
+// Compute the output values for a batch of samples using the single-precision weights
+//
+void SLPOutputLayer::computeBatchInto(const float* input, int count, float* output) const
+{
+    const int rows = m_singleInWeights.rows();
+    const float* bias = m_singleInWeights.biasData();
+
+    VectorKernels::multiplyTransposed(input, count, m_singleInWeights.rowData(0), rows,
+                                      m_singleInWeights.columns(), output);
+    for (int i = 0; i < count; i++) {
+        float* values = output + i * rows;
+        for (int row = 0; row < rows; row++)
+            values[row] = static_cast<float>(activate(values[row] + bias[row]));
+    }
+}
+
+//
+// Transfer function of the output neurons, the perceptron uses the step function
+//
+double SLPOutputLayer::activate(double value) const
+{
+    return (value >= 0) ? 1 : 0;
+}
+
 //
 // Change learning rate of the output neurons
 //
 void SLPOutputLayer::setLearningRate(double learningRate)
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* n = qobject_cast<SLPOutputNeuron*>(neuron(i));
-        Q_ASSERT(n != nullptr);
+    Q_ASSERT(learningRate > 0.0 && learningRate <= 1.0);
 
-        n->setLearningRate(learningRate);
-    }
+    m_optimizer.setLearningRate(learningRate);
+}
+
+//
+// Change the rule used to update the weights, Adaline uses this to select its
+// optimizer. Only the requested type is recorded here, it is applied at the
+// next resetOptimizer() call. SLPNetwork never calls this, so the perceptron
+// keeps the plain gradient descent.
+//
+void SLPOutputLayer::setOptimizer(NetworkInfo::Optimizer optimizer)
+{
+    m_optimizer.setType(optimizer);
+}
+
+void SLPOutputLayer::resetOptimizer()
+{
+    m_optimizer.reset();
 }
 
 QString SLPOutputLayer::defaultNeuronName(int index) const
@@ -99,11 +162,23 @@ QString SLPOutputLayer::defaultNeuronName(int index) const
 
 void SLPOutputLayer::train(const TrainingSample& sample)
 {
-    for (int i = 0; i < neuronCount(); i++) {
-        auto* n = qobject_cast<SLPOutputNeuron*>(neuron(i));
-        Q_ASSERT(n != nullptr);
-
-        n->train(sample.inputs(), static_cast<int>(sample.output(i)));
+    const auto& input = sample.inputs();
+    Q_ASSERT(input.size() == m_inWeights.columns());
+
+    computeInto(input.constData(), m_activations.data());
+
+    m_optimizer.beginUpdate(m_inWeights);
+    for (int row = 0; row < m_inWeights.rows(); row++) {
+        double diff = m_activations.at(row) - sample.output(row);
+        //
+        // Rows without error may only be skipped when the optimizer does not
+        // keep any state
+        //
+        if (diff == 0.0 && m_optimizer.isStateless())
+            continue;
+
+        m_optimizer.updateRow(m_inWeights, row, diff, input.constData());
     }
-    updateInConnectionRange();
+    syncNeuronValues();
+    syncInConnectionWeights();
 }
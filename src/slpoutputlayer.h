@@ -21,6 +21,7 @@
 
 #include "common.h"
 
+#include "networkoptimizer.h"
 #include "savednetworklayer.h"
 #include "slplayer.h"
 
@@ -38,9 +39,18 @@ public:
 
     QVector<double> compute(const QVector<double>& input) const override;
     void computeAndSet(const QVector<double>& input);
+    void computeInto(const double* input, double* output) const;
+    void computeBatchInto(const double* input, int count, double* output) const;
+    void computeBatchInto(const float* input, int count, float* output) const;
     void setLearningRate(double learningRate);
+    void setOptimizer(NetworkInfo::Optimizer optimizer);
+    void resetOptimizer();
     void train(const TrainingSample& sample);
 
 protected:
     QString defaultNeuronName(int index) const override;
+    virtual double activate(double value) const;
+
+private:
+    NetworkOptimizer m_optimizer;
 };
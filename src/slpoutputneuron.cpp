@@ -31,52 +31,6 @@ SLPOutputNeuron::SLPOutputNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer*
 {
 }
 
-double SLPOutputNeuron::compute(const QVector<double>& input) const
-{
-    // Bias unit
-    double value = inConnection(0)->weight();
-    //
-    // Connections from the real input neurons
-    //
-    for (int i = 1; i < inConnectionCount(); i++)
-        value += input[i - 1] * inConnection(i)->weight();
-
-    return (value >= 0) ? 1 : 0;
-}
-
-double SLPOutputNeuron::learningRate() const
-{
-    return m_learningRate;
-}
-
-//
-// Change output neuron learning rate
-//
-void SLPOutputNeuron::setLearningRate(double learningRate)
-{
-    Q_ASSERT(learningRate > 0.0 && learningRate <= 1.0);
-
-    m_learningRate = learningRate;
-}
-
-void SLPOutputNeuron::train(const QVector<double>& input, int target)
-{
-    int value = compute(input);
-    int diff = value - target;
-    if (diff != 0) {
-        for (int i = 0; i < inConnectionCount(); i++) {
-            auto* conn = inConnection(i);
-
-            double weight = m_learningRate * diff;
-            if (i > 0)
-                weight *= input[i - 1];
-
-            conn->setWeight(conn->weight() - weight);
-        }
-    }
-    setValue(value);
-}
-
 void SLPOutputNeuron::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
     QColor color;
@@ -33,15 +33,8 @@ public:
     explicit SLPOutputNeuron(NetworkLayer* parent = nullptr);
     explicit SLPOutputNeuron(SavedNetworkNeuron* savedNeuron, NetworkLayer* parent = nullptr);
 
-    virtual double compute(const QVector<double>& input) const;
-    virtual void train(const QVector<double>& input, int target);
-
-    double learningRate() const;
-    void setLearningRate(double learningRate);
-
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
 
 private:
-    double m_learningRate = 1.0;
     QColor m_lastColor;
 };
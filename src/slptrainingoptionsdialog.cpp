@@ -65,6 +65,15 @@ void SLPTrainingOptionsDialog::init()
 
     if (map.contains(NetworkInfo::Key::SampleSelectionOrder))
         ui->comboBoxSampleSelectionOrder->setCurrentIndex(NetworkInfo::sampleSelectionOrderIndexFromMap(map));
+
+    ui->comboBoxEvaluationMode->addItems(NetworkInfo::evaluationModeStringList());
+    ui->comboBoxEvaluationMode->setCurrentIndex(
+                NetworkInfo::evaluationModeToIndex(m_network->evaluationMode()));
+    ui->editEvaluationInterval->setValue(m_network->evaluationInterval());
+
+    ui->comboBoxEvaluationPrecision->addItems(NetworkInfo::evaluationPrecisionStringList());
+    ui->comboBoxEvaluationPrecision->setCurrentIndex(
+                NetworkInfo::evaluationPrecisionToIndex(m_network->evaluationPrecision()));
 }
 
 void SLPTrainingOptionsDialog::accept()
@@ -91,6 +100,14 @@ void SLPTrainingOptionsDialog::accept()
                 NetworkInfo::sampleSelectionOrderFromIndex(
                     ui->comboBoxSampleSelectionOrder->currentIndex()));
 
+    m_network->setEvaluationMode(
+                NetworkInfo::evaluationModeFromIndex(
+                    ui->comboBoxEvaluationMode->currentIndex()));
+    m_network->setEvaluationInterval(ui->editEvaluationInterval->value());
+    m_network->setEvaluationPrecision(
+                NetworkInfo::evaluationPrecisionFromIndex(
+                    ui->comboBoxEvaluationPrecision->currentIndex()));
+
     QDialog::accept();
 }
 
@@ -108,3 +125,12 @@ void SLPTrainingOptionsDialog::on_checkBoxStopPercentage_clicked(bool checked)
 {
     ui->editStopPercentage->setEnabled(checked);
 }
+
+void SLPTrainingOptionsDialog::on_comboBoxEvaluationMode_currentIndexChanged(int index)
+{
+    //
+    // The interval is only used by the interval evaluation mode
+    //
+    ui->editEvaluationInterval->setEnabled(
+                NetworkInfo::evaluationModeFromIndex(index) == NetworkInfo::EvaluationMode::Interval);
+}
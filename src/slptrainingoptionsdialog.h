@@ -42,6 +42,7 @@ private slots:
     void on_checkBoxMaxEpochs_clicked(bool checked);
     void on_checkBoxStopSamples_clicked(bool checked);
     void on_checkBoxStopPercentage_clicked(bool checked);
+    void on_comboBoxEvaluationMode_currentIndexChanged(int index);
 
 private:
     void init();
@@ -51,6 +51,16 @@ void SupervisedChartView::init()
             return;
         refreshLines();
     });
+    connect(network(), &Network::weightsUpdated, this, [this](const QBitArray& layers) {
+        //
+        // The lines are refreshed on every sample done during training, only manual
+        // weight changes are handled here
+        //
+        if (!m_update || network()->isTraining())
+            return;
+        if (m_layerIndex >= 0 && layers.testBit(m_layerIndex + 1))
+            refreshLines();
+    });
 
     /*
      * TODO: mark current input, also when training
@@ -227,10 +237,6 @@ void SupervisedChartView::addLine(int neuronIndex)
     connect(neuron, &NetworkNeuron::nameChanged, this, [neuron, series] {
         series->setName(neuron->name());
     });
-    connect(neuron, &NetworkNeuron::inWeightChanged, this, [this, neuronIndex] {
-        if (m_update && !network()->isTraining())
-            refreshLine(neuronIndex);
-    });
     m_lineSeriesMap[neuronIndex] = series;
     refreshLine(neuronIndex);
 }
@@ -51,7 +51,7 @@ void SupervisedErrorChartWidget::init()
             updateLabel();
     });
 
-    connect(m_network, &Network::neuronWeightChanged, this, [this] {
+    connect(m_network, &Network::weightsUpdated, this, [this] {
         //
         // Update the error in the label when some weight changes manually
         //
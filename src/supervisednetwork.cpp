@@ -19,6 +19,12 @@
  */
 #include "supervisednetwork.h"
 
+#include <algorithm>
+#include <QFuture>
+#include <QMutexLocker>
+#include <QThread>
+#include <QtConcurrentRun>
+
 SupervisedNetwork::SupervisedNetwork(QObject* parent) :
     Network(parent)
 {
@@ -35,44 +41,147 @@ void SupervisedNetwork::init()
 {
     const auto& store = trainingTableModel()->store();
     connect(&store, &TrainingSampleStore::samplesChanged, this, [this] {
-        m_updateNeeded = true;
+        m_updateNeeded.storeRelease(1);
     });
 
-    connect(this, &Network::neuronWeightChanged, this, [this] {
-        m_updateNeeded = true;
+    //
+    // During training the weights only change in the training thread, which
+    // decides when the status is evaluated
+    //
+    connect(this, &Network::weightsUpdated, this, [this] {
+        if (!isTraining())
+            m_updateNeeded.storeRelease(1);
+    });
+    //
+    // Make sure the status is exact once the training is interrupted
+    //
+    connect(this, &Network::trainingPaused, this, [this] {
+        m_updateNeeded.storeRelease(1);
     });
-    connect(this, &Network::trainingSampleDone, this, [this] {
-        m_updateNeeded = true;
+    connect(this, &Network::trainingStopped, this, [this] {
+        m_updateNeeded.storeRelease(1);
     });
+    m_updateNeeded.storeRelease(1);
 }
 
-double SupervisedNetwork::correctPercentage()
+//
+// Rule used to update the weights of the network, plain gradient descent unless
+// set otherwise
+//
+NetworkInfo::Optimizer SupervisedNetwork::optimizer() const
 {
-    if (m_updateNeeded) {
-        updateCurrentStatus();
-        m_updateNeeded = false;
+    if (m_infoMap.contains(NetworkInfo::Key::Optimizer))
+        return NetworkInfo::optimizerFromMap(m_infoMap);
+
+    return NetworkInfo::Optimizer::SGD;
+}
+
+void SupervisedNetwork::setOptimizer(NetworkInfo::Optimizer optimizer)
+{
+    Q_ASSERT(optimizer != NetworkInfo::Optimizer::Unknown);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (optimizer != this->optimizer()) {
+        m_infoMap[NetworkInfo::Key::Optimizer] = QVariant::fromValue(optimizer);
+        emit infoChanged();
+    }
+}
+
+//
+// Method used to train the linear output weights, this is only used by the
+// Adaline and RBF networks
+//
+NetworkInfo::TrainingMethod SupervisedNetwork::trainingMethod() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::TrainingMethod))
+        return NetworkInfo::trainingMethodFromMap(m_infoMap);
+
+    return NetworkInfo::TrainingMethod::LMS;
+}
+
+void SupervisedNetwork::setTrainingMethod(NetworkInfo::TrainingMethod method)
+{
+    Q_ASSERT(method != NetworkInfo::TrainingMethod::Unknown);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (method != trainingMethod()) {
+        m_infoMap[NetworkInfo::Key::TrainingMethod] = QVariant::fromValue(method);
+        emit infoChanged();
     }
+}
+
+//
+// Ridge regularization of the solved output weights, no regularization is used
+// unless set otherwise
+//
+double SupervisedNetwork::ridgeRegularization() const
+{
+    if (m_infoMap.contains(NetworkInfo::Key::RidgeRegularization))
+        return m_infoMap[NetworkInfo::Key::RidgeRegularization].toDouble();
+
+    return 0.0;
+}
+
+void SupervisedNetwork::setRidgeRegularization(double ridge)
+{
+    Q_ASSERT(ridge >= 0.0);
+
+    QMutexLocker locker(&trainingMutex());
+
+    if (!qFuzzyCompare(ridge, ridgeRegularization())) {
+        m_infoMap[NetworkInfo::Key::RidgeRegularization] = ridge;
+        emit infoChanged();
+    }
+}
+
+double SupervisedNetwork::correctPercentage()
+{
+    QMutexLocker locker(&trainingMutex());
+
+    updateCurrentStatusIfNeeded();
     return m_correctPercentage;
 }
 
 int SupervisedNetwork::correctSamples()
 {
-    if (m_updateNeeded) {
-        updateCurrentStatus();
-        m_updateNeeded = false;
-    }
+    QMutexLocker locker(&trainingMutex());
+
+    updateCurrentStatusIfNeeded();
     return m_correctSamples;
 }
 
 double SupervisedNetwork::error()
 {
-    if (m_updateNeeded) {
-        updateCurrentStatus();
-        m_updateNeeded = false;
-    }
+    QMutexLocker locker(&trainingMutex());
+
+    updateCurrentStatusIfNeeded();
     return m_error;
 }
 
+//
+// Evaluate the network on the whole training set regardless of the evaluation mode
+//
+void SupervisedNetwork::evaluate()
+{
+    QMutexLocker locker(&trainingMutex());
+
+    m_updateNeeded.storeRelease(0);
+    m_samplesSinceEvaluation = 0;
+    updateCurrentStatus();
+}
+
+//
+// The status is computed from the layers, so the training mutex must be locked
+// as the network may be trained from another thread
+//
+void SupervisedNetwork::updateCurrentStatusIfNeeded()
+{
+    if (m_updateNeeded.testAndSetOrdered(1, 0))
+        updateCurrentStatus();
+}
+
 bool SupervisedNetwork::isStopConditionReached(Network::StopTrainingReason* reason)
 {
     int neededSamples = stopSamples();
@@ -93,21 +202,172 @@ bool SupervisedNetwork::isStopConditionReached(Network::StopTrainingReason* reas
     return false;
 }
 
+//
+// Decide whether the status has to be evaluated after the given sample has been
+// trained, this is called from the training thread.
+//
+// Evaluating the status runs the network on the whole training set, so doing it
+// after every sample makes the training quadratic in the number of samples.
+//
+void SupervisedNetwork::sampleTrained(const TrainingSample& sample)
+{
+    int sampleCount = trainingTableModel()->store().samples().size();
+
+    switch (evaluationMode()) {
+        case NetworkInfo::EvaluationMode::Interval:
+            if (++m_samplesSinceEvaluation < evaluationInterval())
+                return;
+            break;
+        case NetworkInfo::EvaluationMode::TrainingSet:
+            if (++m_samplesSinceEvaluation < sampleCount)
+                return;
+            break;
+        case NetworkInfo::EvaluationMode::MovingAverage:
+            //
+            // Start from the exact status when it is not known, then only
+            // update the estimate using the output computed while training
+            //
+            updateCurrentStatusIfNeeded();
+            if (sampleCount > 0)
+                updateMovingAverage(outputLayer()->activations(), sample,
+                                    2.0 / (sampleCount + 1));
+            return;
+        default:
+            break;
+    }
+    m_samplesSinceEvaluation = 0;
+    m_updateNeeded.storeRelease(1);
+}
+
+//
+// Update the status estimate with the output the network produced for the given
+// sample before its weights were adjusted.
+//
+// The estimate is an exponential moving average whose weight makes it span about
+// one pass through the training set. The number of correct samples is estimated
+// as well, so that the stop conditions based on it can be reached.
+//
+void SupervisedNetwork::updateMovingAverage(const QVector<double>& outputs,
+                                            const TrainingSample& sample,
+                                            double weight)
+{
+    double error = 0.0;
+    for (int i = 0; i < outputs.size(); i++) {
+        double diff = outputs.at(i) - sample.output(i);
+        error += diff * diff;
+    }
+    m_error += weight * (error - m_error);
+
+    double correct = (error == 0.0) ? 100.0 : 0.0;
+    int sampleCount = trainingTableModel()->store().samples().size();
+
+    m_correctPercentage += weight * (correct - m_correctPercentage);
+    m_correctSamples = qRound(m_correctPercentage / 100.0 * sampleCount);
+}
+
 void SupervisedNetwork::updateCurrentStatus()
 {
     //
-    // This is the general implementation which calculates the MSE error
+    // This is the general implementation which calculates the MSE error and the
+    // number of samples whose output matches the expected output exactly.
+    //
+    // The training set is split into parts which are evaluated in parallel, every
+    // part by its own thread with its own workspace. This thread evaluates the
+    // first part while waiting for the others.
     //
-    m_error = 0.0;
     const auto& samples = trainingTableModel()->store().samples();
-    if (samples.size() > 0) {
-        for (const auto& sample : samples) {
-            auto outputs = compute(sample.inputs());
-            for (int i = 0; i < outputs.size(); i++) {
-                double diff = outputs.at(i) - sample.output(i);
-                m_error += diff * diff;
+    const int count = samples.size();
+
+    if (evaluationPrecision() == NetworkInfo::EvaluationPrecision::Single)
+        updateSingleWeights();
+
+    int threads = qBound(1, count / EvaluationChunkSize, qMax(1, QThread::idealThreadCount()));
+    int chunk = (count + threads - 1) / threads;
+
+    QVector<QFuture<EvaluationSums>> futures;
+    for (int begin = chunk; begin < count; begin += chunk) {
+        int end = qMin(begin + chunk, count);
+        futures.append(QtConcurrent::run([this, &samples, begin, end] {
+            return evaluateSamples(samples, begin, end);
+        }));
+    }
+    auto sums = evaluateSamples(samples, 0, qMin(chunk, count));
+    for (auto& future : futures) {
+        const auto partial = future.result();
+        sums.error += partial.error;
+        sums.correctSamples += partial.correctSamples;
+    }
+
+    m_correctSamples = sums.correctSamples;
+    if (count > 0) {
+        m_error = sums.error / count;
+        m_correctPercentage = 100.0 * (m_correctSamples / static_cast<double>(count));
+    } else {
+        m_error = 0.0;
+        m_correctPercentage = 0.0;
+    }
+}
+
+//
+// Evaluate the samples in the range [begin, end), this may run in any thread
+//
+SupervisedNetwork::EvaluationSums SupervisedNetwork::evaluateSamples(const QVector<TrainingSample>& samples,
+                                                                     int begin, int end) const
+{
+    EvaluationSums sums;
+    if (begin >= end)
+        return sums;
+
+    const int inputCount = inputLayer()->activations().size();
+    const int outputCount = outputLayer()->activations().size();
+    //
+    // The samples are computed in batches, which lets the layers compute the
+    // values of all samples of a batch at once
+    //
+    auto workspace = createWorkspace();
+    const bool single = (evaluationPrecision() == NetworkInfo::EvaluationPrecision::Single);
+    QVector<double> inputs(single ? 0 : EvaluationBatchSize * inputCount);
+    QVector<double> outputs(EvaluationBatchSize * outputCount);
+    QVector<float> singleInputs(single ? EvaluationBatchSize * inputCount : 0);
+    QVector<float> singleOutputs(single ? EvaluationBatchSize * outputCount : 0);
+
+    for (int first = begin; first < end; first += EvaluationBatchSize) {
+        const int count = qMin(end - first, static_cast<int>(EvaluationBatchSize));
+        //
+        // In single precision the samples are converted when they are packed,
+        // only the error is summed in double precision
+        //
+        if (single) {
+            for (int i = 0; i < count; i++) {
+                const auto& sampleInputs = samples.at(first + i).inputs();
+                std::copy(sampleInputs.constBegin(), sampleInputs.constEnd(),
+                          singleInputs.begin() + i * inputCount);
+            }
+            computeBatch(singleInputs.constData(), count, singleOutputs.data(), workspace);
+            std::copy(singleOutputs.constBegin(), singleOutputs.constBegin() + count * outputCount,
+                      outputs.begin());
+        } else {
+            for (int i = 0; i < count; i++) {
+                const auto& sampleInputs = samples.at(first + i).inputs();
+                std::copy(sampleInputs.constBegin(), sampleInputs.constEnd(),
+                          inputs.begin() + i * inputCount);
+            }
+            computeBatch(inputs.constData(), count, outputs.data(), workspace);
+        }
+
+        for (int i = 0; i < count; i++) {
+            const auto& sample = samples.at(first + i);
+            const double* values = outputs.constData() + i * outputCount;
+
+            double error = 0.0;
+            for (int j = 0; j < outputCount; j++) {
+                double diff = values[j] - sample.output(j);
+                error += diff * diff;
             }
+            sums.error += error;
+            if (error == 0.0)
+                sums.correctSamples++;
         }
-        m_error /= samples.size();
     }
+    return sums;
 }
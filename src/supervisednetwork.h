@@ -22,6 +22,7 @@
 #include "common.h"
 
 #include "network.h"
+#include "trainingsample.h"
 
 class SupervisedNetwork : public Network {
     Q_OBJECT
@@ -41,16 +42,52 @@ public:
 
     virtual ErrorValueType errorValueType() { return ErrorValueType::DoubleValue; }
 
+    void evaluate();
+
+    NetworkInfo::Optimizer optimizer() const;
+    void setOptimizer(NetworkInfo::Optimizer optimizer);
+    NetworkInfo::TrainingMethod trainingMethod() const;
+    void setTrainingMethod(NetworkInfo::TrainingMethod method);
+    double ridgeRegularization() const;
+    void setRidgeRegularization(double ridge);
+
 protected:
     bool isStopConditionReached(StopTrainingReason* reason) override;
+    void sampleTrained(const TrainingSample& sample) override;
     virtual void updateCurrentStatus();
+    virtual void updateMovingAverage(const QVector<double>& outputs,
+                                     const TrainingSample& sample,
+                                     double weight);
 
     double m_correctPercentage = 0.0;
     int m_correctSamples = 0;
     double m_error = 0.0;
 
 private:
+    //
+    // Partial results of evaluating a part of the training set
+    //
+    struct EvaluationSums {
+        double error = 0.0;
+        int correctSamples = 0;
+    };
+
+    //
+    // Minimal number of samples evaluated by a single thread
+    //
+    static constexpr int EvaluationChunkSize = 256;
+    //
+    // Number of samples computed together by a single thread
+    //
+    static constexpr int EvaluationBatchSize = 64;
+
     void init();
+    void updateCurrentStatusIfNeeded();
+    EvaluationSums evaluateSamples(const QVector<TrainingSample>& samples, int begin, int end) const;
 
-    bool m_updateNeeded = false;
+    //
+    // Set from the GUI thread as well as from the training thread
+    //
+    QAtomicInt m_updateNeeded;
+    int m_samplesSinceEvaluation = 0;
 };
@@ -57,9 +57,11 @@ void TrainingTableModel::setOutputs(const QStringList &outputs)
 // advance the internal pointer to make this method return the next item
 // in sequence the next time it is called.
 //
+// The position of the item is stored in index if it is not null.
+//
 // The sample list must not be empty.
 //
-const TrainingSample& TrainingTableModel::currentSample(bool advance)
+const TrainingSample& TrainingTableModel::currentSample(bool advance, int* index)
 {
     const auto& samples = m_store.samples();
 
@@ -67,6 +69,8 @@ const TrainingSample& TrainingTableModel::currentSample(bool advance)
     Q_ASSERT(m_currentPosition < samples.size());
 
     const auto& item = samples.at(m_currentPosition);
+    if (index)
+        *index = m_currentPosition;
     if (advance) {
         // Start over when the end of sequence is reached
         if (++m_currentPosition == samples.size())
@@ -78,16 +82,21 @@ const TrainingSample& TrainingTableModel::currentSample(bool advance)
 //
 // Retrieve a random item from the training set
 //
+// The position of the item is stored in index if it is not null.
+//
 // The sample list must not be empty.
 //
-const TrainingSample& TrainingTableModel::randomSample()
+const TrainingSample& TrainingTableModel::randomSample(int* index)
 {
     const auto& samples = m_store.samples();
 
     Q_ASSERT(samples.size() > 0);
 
     std::uniform_int_distribution<int> dist(0, samples.size() - 1);
-    return samples.at(dist(m_generator));
+    int position = dist(m_generator);
+    if (index)
+        *index = position;
+    return samples.at(position);
 }
 
 //
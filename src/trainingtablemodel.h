@@ -60,8 +60,8 @@ public:
     QStringList outputs() const;
     void setOutputs(const QStringList &outputs);
 
-    const TrainingSample &currentSample(bool advance = true);
-    const TrainingSample &randomSample();
+    const TrainingSample &currentSample(bool advance = true, int* index = nullptr);
+    const TrainingSample &randomSample(int* index = nullptr);
     const TrainingSample &sample(int index) const;
 
     bool isEmpty() const;
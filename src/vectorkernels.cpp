@@ -0,0 +1,542 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "vectorkernels.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_KERNELS_X86
+#define VECTOR_KERNELS_TARGET(arch) __attribute__((target(arch)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define VECTOR_KERNELS_X86
+#define VECTOR_KERNELS_TARGET(arch)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace {
+
+struct Kernels {
+    double (*dot)(const double*, const double*, int);
+    double (*squaredDistance)(const double*, const double*, int);
+    double (*squaredDistanceBounded)(const double*, const double*, int, double);
+    void (*axpy)(double, const double*, double*, int);
+    float (*dotSingle)(const float*, const float*, int);
+    float (*squaredDistanceSingle)(const float*, const float*, int);
+    const char* name;
+};
+
+// ===
+// Scalar implementation
+// ===
+
+double dotScalar(const double* x, const double* y, int size)
+{
+    double sum = 0.0;
+    for (int i = 0; i < size; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+double squaredDistanceScalar(const double* x, const double* y, int size)
+{
+    double sum = 0.0;
+    for (int i = 0; i < size; i++) {
+        double diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+//
+// The bounded distances sum the values in the same order as the plain ones and
+// only read the partial sum every 8 values to compare it with the bound
+//
+double squaredDistanceBoundedScalar(const double* x, const double* y, int size, double bound)
+{
+    double sum = 0.0;
+    for (int i = 0; i < size; i++) {
+        double diff = x[i] - y[i];
+        sum += diff * diff;
+        if ((i & 7) == 7 && sum > bound)
+            return sum;
+    }
+    return sum;
+}
+
+void axpyScalar(double a, const double* x, double* y, int size)
+{
+    for (int i = 0; i < size; i++)
+        y[i] += a * x[i];
+}
+
+float dotSingleScalar(const float* x, const float* y, int size)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < size; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+float squaredDistanceSingleScalar(const float* x, const float* y, int size)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < size; i++) {
+        float diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+#ifdef VECTOR_KERNELS_X86
+
+// ===
+// SSE2 implementation
+// ===
+
+VECTOR_KERNELS_TARGET("sse2")
+double horizontalSum(__m128d sum)
+{
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+VECTOR_KERNELS_TARGET("sse2")
+double dotSSE2(const double* x, const double* y, int size)
+{
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= size; i += 4) {
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+    }
+    double sum = horizontalSum(_mm_add_pd(sum0, sum1));
+    for (; i < size; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("sse2")
+double squaredDistanceSSE2(const double* x, const double* y, int size)
+{
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m128d diff0 = _mm_sub_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+        __m128d diff1 = _mm_sub_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2));
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(diff0, diff0));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(diff1, diff1));
+    }
+    double sum = horizontalSum(_mm_add_pd(sum0, sum1));
+    for (; i < size; i++) {
+        double diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("sse2")
+double squaredDistanceBoundedSSE2(const double* x, const double* y, int size, double bound)
+{
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m128d diff0 = _mm_sub_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+        __m128d diff1 = _mm_sub_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2));
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(diff0, diff0));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(diff1, diff1));
+        if ((i & 4) != 0) {
+            double partial = horizontalSum(_mm_add_pd(sum0, sum1));
+            if (partial > bound)
+                return partial;
+        }
+    }
+    double sum = horizontalSum(_mm_add_pd(sum0, sum1));
+    for (; i < size; i++) {
+        double diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("sse2")
+void axpySSE2(double a, const double* x, double* y, int size)
+{
+    const __m128d factor = _mm_set1_pd(a);
+    int i = 0;
+    for (; i + 2 <= size; i += 2) {
+        __m128d value = _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(factor, _mm_loadu_pd(x + i)));
+        _mm_storeu_pd(y + i, value);
+    }
+    for (; i < size; i++)
+        y[i] += a * x[i];
+}
+
+VECTOR_KERNELS_TARGET("sse2")
+float horizontalSum(__m128 sum)
+{
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+VECTOR_KERNELS_TARGET("sse2")
+float dotSingleSSE2(const float* x, const float* y, int size)
+{
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(y + i + 4)));
+    }
+    float sum = horizontalSum(_mm_add_ps(sum0, sum1));
+    for (; i < size; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("sse2")
+float squaredDistanceSingleSSE2(const float* x, const float* y, int size)
+{
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m128 diff0 = _mm_sub_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i));
+        __m128 diff1 = _mm_sub_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(y + i + 4));
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(diff0, diff0));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(diff1, diff1));
+    }
+    float sum = horizontalSum(_mm_add_ps(sum0, sum1));
+    for (; i < size; i++) {
+        float diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+// ===
+// AVX2 implementation
+// ===
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+double horizontalSum(__m256d sum)
+{
+    __m128d low = _mm256_castpd256_pd128(sum);
+    __m128d high = _mm256_extractf128_pd(sum, 1);
+    low = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+double dotAVX2(const double* x, const double* y, int size)
+{
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+        sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), sum1);
+    }
+    if (i + 4 <= size) {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+        i += 4;
+    }
+    double sum = horizontalSum(_mm256_add_pd(sum0, sum1));
+    for (; i < size; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+double squaredDistanceAVX2(const double* x, const double* y, int size)
+{
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m256d diff0 = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        __m256d diff1 = _mm256_sub_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+        sum0 = _mm256_fmadd_pd(diff0, diff0, sum0);
+        sum1 = _mm256_fmadd_pd(diff1, diff1, sum1);
+    }
+    if (i + 4 <= size) {
+        __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        sum0 = _mm256_fmadd_pd(diff, diff, sum0);
+        i += 4;
+    }
+    double sum = horizontalSum(_mm256_add_pd(sum0, sum1));
+    for (; i < size; i++) {
+        double diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+double squaredDistanceBoundedAVX2(const double* x, const double* y, int size, double bound)
+{
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m256d diff0 = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        __m256d diff1 = _mm256_sub_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+        sum0 = _mm256_fmadd_pd(diff0, diff0, sum0);
+        sum1 = _mm256_fmadd_pd(diff1, diff1, sum1);
+        double partial = horizontalSum(_mm256_add_pd(sum0, sum1));
+        if (partial > bound)
+            return partial;
+    }
+    if (i + 4 <= size) {
+        __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        sum0 = _mm256_fmadd_pd(diff, diff, sum0);
+        i += 4;
+    }
+    double sum = horizontalSum(_mm256_add_pd(sum0, sum1));
+    for (; i < size; i++) {
+        double diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+void axpyAVX2(double a, const double* x, double* y, int size)
+{
+    const __m256d factor = _mm256_set1_pd(a);
+    int i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256d value = _mm256_fmadd_pd(factor, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        _mm256_storeu_pd(y + i, value);
+    }
+    for (; i < size; i++)
+        y[i] += a * x[i];
+}
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+float horizontalSum(__m256 sum)
+{
+    __m128 low = _mm256_castps256_ps128(sum);
+    __m128 high = _mm256_extractf128_ps(sum, 1);
+    low = _mm_add_ps(low, high);
+    low = _mm_add_ps(low, _mm_movehl_ps(low, low));
+    low = _mm_add_ss(low, _mm_shuffle_ps(low, low, 1));
+    return _mm_cvtss_f32(low);
+}
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+float dotSingleAVX2(const float* x, const float* y, int size)
+{
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 16 <= size; i += 16) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), sum1);
+    }
+    if (i + 8 <= size) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), sum0);
+        i += 8;
+    }
+    float sum = horizontalSum(_mm256_add_ps(sum0, sum1));
+    for (; i < size; i++)
+        sum += x[i] * y[i];
+
+    return sum;
+}
+
+VECTOR_KERNELS_TARGET("avx2,fma")
+float squaredDistanceSingleAVX2(const float* x, const float* y, int size)
+{
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m256 diff0 = _mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+        __m256 diff1 = _mm256_sub_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8));
+        sum0 = _mm256_fmadd_ps(diff0, diff0, sum0);
+        sum1 = _mm256_fmadd_ps(diff1, diff1, sum1);
+    }
+    if (i + 8 <= size) {
+        __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+        sum0 = _mm256_fmadd_ps(diff, diff, sum0);
+        i += 8;
+    }
+    float sum = horizontalSum(_mm256_add_ps(sum0, sum1));
+    for (; i < size; i++) {
+        float diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+bool cpuSupportsAVX2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    //
+    // FMA, OSXSAVE and AVX, the OS must also save the YMM registers
+    //
+    const int features = (1 << 12) | (1 << 27) | (1 << 28);
+    if ((info[2] & features) != features)
+        return false;
+    if ((_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+bool cpuSupportsSSE2()
+{
+#if defined(_MSC_VER)
+    // Always available on x86-64
+    return true;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif // VECTOR_KERNELS_X86
+
+Kernels selectKernels()
+{
+#ifdef VECTOR_KERNELS_X86
+    if (cpuSupportsAVX2())
+        return { dotAVX2, squaredDistanceAVX2, squaredDistanceBoundedAVX2, axpyAVX2,
+                 dotSingleAVX2, squaredDistanceSingleAVX2, "AVX2" };
+    if (cpuSupportsSSE2())
+        return { dotSSE2, squaredDistanceSSE2, squaredDistanceBoundedSSE2, axpySSE2,
+                 dotSingleSSE2, squaredDistanceSingleSSE2, "SSE2" };
+#endif
+    return { dotScalar, squaredDistanceScalar, squaredDistanceBoundedScalar, axpyScalar,
+             dotSingleScalar, squaredDistanceSingleScalar, "scalar" };
+}
+
+//
+// The kernels are selected once on the first use
+//
+const Kernels& kernels()
+{
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+//
+// Number of rows of each matrix processed together, a block of both matrices
+// should fit into the cache for the usual number of columns
+//
+constexpr int BlockRows = 32;
+
+template<typename T, typename Kernel>
+void blockedProduct(Kernel kernel, const T* a, int aRows, const T* b, int bRows,
+                    int columns, T* c)
+{
+    for (int i0 = 0; i0 < aRows; i0 += BlockRows) {
+        const int i1 = qMin(i0 + BlockRows, aRows);
+        for (int j0 = 0; j0 < bRows; j0 += BlockRows) {
+            const int j1 = qMin(j0 + BlockRows, bRows);
+            for (int i = i0; i < i1; i++) {
+                const T* row = a + i * columns;
+                T* result = c + i * bRows;
+                for (int j = j0; j < j1; j++)
+                    result[j] = kernel(row, b + j * columns, columns);
+            }
+        }
+    }
+}
+
+} // namespace
+
+double VectorKernels::dot(const double* x, const double* y, int size)
+{
+    return kernels().dot(x, y, size);
+}
+
+double VectorKernels::squaredDistance(const double* x, const double* y, int size)
+{
+    return kernels().squaredDistance(x, y, size);
+}
+
+double VectorKernels::squaredDistanceBounded(const double* x, const double* y, int size,
+                                             double bound)
+{
+    return kernels().squaredDistanceBounded(x, y, size, bound);
+}
+
+void VectorKernels::axpy(double a, const double* x, double* y, int size)
+{
+    kernels().axpy(a, x, y, size);
+}
+
+void VectorKernels::multiplyTransposed(const double* a, int aRows, const double* b, int bRows,
+                                       int columns, double* c)
+{
+    blockedProduct(kernels().dot, a, aRows, b, bRows, columns, c);
+}
+
+void VectorKernels::squaredDistances(const double* a, int aRows, const double* b, int bRows,
+                                     int columns, double* c)
+{
+    blockedProduct(kernels().squaredDistance, a, aRows, b, bRows, columns, c);
+}
+
+float VectorKernels::dot(const float* x, const float* y, int size)
+{
+    return kernels().dotSingle(x, y, size);
+}
+
+float VectorKernels::squaredDistance(const float* x, const float* y, int size)
+{
+    return kernels().squaredDistanceSingle(x, y, size);
+}
+
+void VectorKernels::multiplyTransposed(const float* a, int aRows, const float* b, int bRows,
+                                       int columns, float* c)
+{
+    blockedProduct(kernels().dotSingle, a, aRows, b, bRows, columns, c);
+}
+
+void VectorKernels::squaredDistances(const float* a, int aRows, const float* b, int bRows,
+                                     int columns, float* c)
+{
+    blockedProduct(kernels().squaredDistanceSingle, a, aRows, b, bRows, columns, c);
+}
+
+const char* VectorKernels::instructionSet()
+{
+    return kernels().name;
+}
@@ -0,0 +1,74 @@
+/*-
+ * Copyright (c) 2016-2017 Michal Ratajsky <michal.ratajsky@gmail.com>
+ * All rights reserved.
+ *
+ * This file is part of Neural Network Learning Visualizer (NNLV).
+ *
+ * NNLV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NNLV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with NNLV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "common.h"
+
+//
+// Vector kernels used by the computation of the layers.
+//
+// The kernels are implemented using AVX2 and SSE2 instructions when the compiler
+// supports them, the implementation is picked at run time according to the
+// features of the CPU and falls back to plain C++ loops.
+//
+namespace VectorKernels {
+    double dot(const double* x, const double* y, int size);
+    double squaredDistance(const double* x, const double* y, int size);
+    //
+    // Squared distance which stops early once a partial sum, checked every 8
+    // values, exceeds the bound. The result is then greater than the bound but
+    // not the distance itself.
+    //
+    // The values are summed in the same order as by squaredDistance(), so the
+    // result is identical to it unless the summation stopped early.
+    //
+    double squaredDistanceBounded(const double* x, const double* y, int size, double bound);
+    //
+    // Compute y += a * x
+    //
+    void axpy(double a, const double* x, double* y, int size);
+
+    //
+    // Matrix kernels over row-major matrices with the given number of columns,
+    // the result c has aRows rows and bRows columns.
+    //
+    // Compute c = a * transpose(b)
+    //
+    void multiplyTransposed(const double* a, int aRows, const double* b, int bRows,
+                            int columns, double* c);
+    //
+    // Compute c[i][j] as the squared distance between rows a[i] and b[j]
+    //
+    void squaredDistances(const double* a, int aRows, const double* b, int bRows,
+                          int columns, double* c);
+
+    //
+    // Single-precision variants of the kernels, these process twice as many values
+    // per instruction
+    //
+    float dot(const float* x, const float* y, int size);
+    float squaredDistance(const float* x, const float* y, int size);
+    void multiplyTransposed(const float* a, int aRows, const float* b, int bRows,
+                            int columns, float* c);
+    void squaredDistances(const float* a, int aRows, const float* b, int bRows,
+                          int columns, float* c);
+
+    const char* instructionSet();
+}
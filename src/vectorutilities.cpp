@@ -21,16 +21,13 @@
 
 #include <cmath>
 
+#include "vectorkernels.h"
+
 double VectorUtilities::distance(const QVector<double>& vec1, const QVector<double>& vec2)
 {
     Q_ASSERT(vec1.size() == vec2.size());
 
-    double distance = 0.0;
-    for (int i = 0; i < vec1.size(); i++) {
-        double diff = vec1.at(i) - vec2.at(i);
-        distance += diff * diff;
-    }
-    return std::sqrt(distance);
+    return std::sqrt(VectorKernels::squaredDistance(vec1.constData(), vec2.constData(), vec1.size()));
 }
 
 void VectorUtilities::addEach(QVector<double>& vec, const QVector<double>& addend)
@@ -281,16 +281,126 @@ void XmlWorker::readXmlNetworkTrainingOptions(QXmlStreamReader& xml, SavedNetwor
                 break;
             }
             map[NetworkInfo::Key::ActivationFunction] = QVariant::fromValue(value);
+        } else if (xml.name() == "activation-precision") {
+            //
+            // <activation-precision>
+            //
+            auto value = MLPActivation::precisionFromString(xml.readElementText());
+            if (value == MLPActivation::Precision::Unknown) {
+                xml.raiseError("Invalid <activation-precision> value");
+                break;
+            }
+            map[NetworkInfo::Key::ActivationPrecision] = QVariant::fromValue(value);
+        } else if (xml.name() == "batch-size") {
+            //
+            // <batch-size>
+            //
+            map[NetworkInfo::Key::BatchSize] = xml.readElementText().toInt();
+        } else if (xml.name() == "clustering-batch-size") {
+            //
+            // <clustering-batch-size>
+            //
+            map[NetworkInfo::Key::ClusteringBatchSize] = xml.readElementText().toInt();
+        } else if (xml.name() == "clustering-epsilon") {
+            //
+            // <clustering-epsilon>
+            //
+            map[NetworkInfo::Key::ClusteringEpsilon] = xml.readElementText().toDouble();
+        } else if (xml.name() == "clustering-method") {
+            //
+            // <clustering-method>
+            //
+            auto value = NetworkInfo::clusteringMethodFromString(xml.readElementText());
+            if (value == NetworkInfo::ClusteringMethod::Unknown) {
+                xml.raiseError("Invalid <clustering-method> value");
+                break;
+            }
+            map[NetworkInfo::Key::ClusteringMethod] = QVariant::fromValue(value);
+        } else if (xml.name() == "clustering-restarts") {
+            //
+            // <clustering-restarts>
+            //
+            map[NetworkInfo::Key::ClusteringRestarts] = xml.readElementText().toInt();
+        } else if (xml.name() == "clustering-tolerance") {
+            //
+            // <clustering-tolerance>
+            //
+            map[NetworkInfo::Key::ClusteringTolerance] = xml.readElementText().toDouble();
+        } else if (xml.name() == "evaluation-interval") {
+            //
+            // <evaluation-interval>
+            //
+            map[NetworkInfo::Key::EvaluationInterval] = xml.readElementText().toInt();
+        } else if (xml.name() == "evaluation-mode") {
+            //
+            // <evaluation-mode>
+            //
+            auto value = NetworkInfo::evaluationModeFromString(xml.readElementText());
+            if (value == NetworkInfo::EvaluationMode::Unknown) {
+                xml.raiseError("Invalid <evaluation-mode> value");
+                break;
+            }
+            map[NetworkInfo::Key::EvaluationMode] = QVariant::fromValue(value);
+        } else if (xml.name() == "evaluation-precision") {
+            //
+            // <evaluation-precision>
+            //
+            auto value = NetworkInfo::evaluationPrecisionFromString(xml.readElementText());
+            if (value == NetworkInfo::EvaluationPrecision::Unknown) {
+                xml.raiseError("Invalid <evaluation-precision> value");
+                break;
+            }
+            map[NetworkInfo::Key::EvaluationPrecision] = QVariant::fromValue(value);
+        } else if (xml.name() == "kohonen-training-mode") {
+            //
+            // <kohonen-training-mode>
+            //
+            auto value = NetworkInfo::kohonenTrainingModeFromString(xml.readElementText());
+            if (value == NetworkInfo::KohonenTrainingMode::Unknown) {
+                xml.raiseError("Invalid <kohonen-training-mode> value");
+                break;
+            }
+            map[NetworkInfo::Key::KohonenTrainingMode] = QVariant::fromValue(value);
         } else if (xml.name() == "learning-rate") {
             //
             // <learning-rate>
             //
             map[NetworkInfo::Key::LearningRate] = xml.readElementText().toDouble();
+        } else if (xml.name() == "learning-rate-schedule") {
+            //
+            // <learning-rate-schedule>
+            //
+            auto value = NetworkInfo::scheduleFromString(xml.readElementText());
+            if (value == NetworkInfo::Schedule::Unknown) {
+                xml.raiseError("Invalid <learning-rate-schedule> value");
+                break;
+            }
+            map[NetworkInfo::Key::LearningRateSchedule] = QVariant::fromValue(value);
         } else if (xml.name() == "max-epochs") {
             //
             // <max-epochs>
             //
             map[NetworkInfo::Key::MaxEpochs] = xml.readElementText().toInt();
+        } else if (xml.name() == "neighborhood-schedule") {
+            //
+            // <neighborhood-schedule>
+            //
+            auto value = NetworkInfo::scheduleFromString(xml.readElementText());
+            if (value == NetworkInfo::Schedule::Unknown) {
+                xml.raiseError("Invalid <neighborhood-schedule> value");
+                break;
+            }
+            map[NetworkInfo::Key::NeighborhoodSchedule] = QVariant::fromValue(value);
+        } else if (xml.name() == "optimizer") {
+            //
+            // <optimizer>
+            //
+            auto value = NetworkInfo::optimizerFromString(xml.readElementText());
+            if (value == NetworkInfo::Optimizer::Unknown) {
+                xml.raiseError("Invalid <optimizer> value");
+                break;
+            }
+            map[NetworkInfo::Key::Optimizer] = QVariant::fromValue(value);
         } else if (xml.name() == "pause-after-sample") {
             //
             // <pause-after-sample>
@@ -302,6 +412,11 @@ void XmlWorker::readXmlNetworkTrainingOptions(QXmlStreamReader& xml, SavedNetwor
             else if (value == QStringLiteral("0")
                      || value == QStringLiteral("false"))
                 map[NetworkInfo::Key::PauseAfterSample] = QVariant::fromValue(false);
+        } else if (xml.name() == "ridge-regularization") {
+            //
+            // <ridge-regularization>
+            //
+            map[NetworkInfo::Key::RidgeRegularization] = xml.readElementText().toDouble();
         } else if (xml.name() == "sample-selection-order") {
             //
             // <sample-selection-order>
@@ -338,6 +453,16 @@ void XmlWorker::readXmlNetworkTrainingOptions(QXmlStreamReader& xml, SavedNetwor
             else if (value == QStringLiteral("0")
                      || value == QStringLiteral("false"))
                 map[NetworkInfo::Key::TrainRBFLayer] = QVariant::fromValue(false);
+        } else if (xml.name() == "training-method") {
+            //
+            // <training-method>
+            //
+            auto value = NetworkInfo::trainingMethodFromString(xml.readElementText());
+            if (value == NetworkInfo::TrainingMethod::Unknown) {
+                xml.raiseError("Invalid <training-method> value");
+                break;
+            }
+            map[NetworkInfo::Key::TrainingMethod] = QVariant::fromValue(value);
         } else
             xml.skipCurrentElement();
         if (xml.hasError())
@@ -558,13 +683,59 @@ bool XmlWorker::writeNetwork(const QString& filePath, const Network& network)
     if (map.contains(NetworkInfo::Key::ActivationFunction))
         xml.writeTextElement("activation-function",
                              MLPActivation::functionToString(MLPActivation::functionFromMap(map)));
-
+    if (map.contains(NetworkInfo::Key::ActivationPrecision))
+        xml.writeTextElement("activation-precision",
+                             MLPActivation::precisionToString(MLPActivation::precisionFromMap(map)));
+
+    if (map.contains(NetworkInfo::Key::BatchSize))
+        xml.writeTextElement("batch-size", map.value(NetworkInfo::Key::BatchSize).toString());
+    if (map.contains(NetworkInfo::Key::ClusteringBatchSize))
+        xml.writeTextElement("clustering-batch-size", map.value(NetworkInfo::Key::ClusteringBatchSize).toString());
+    if (map.contains(NetworkInfo::Key::ClusteringEpsilon))
+        xml.writeTextElement("clustering-epsilon", map.value(NetworkInfo::Key::ClusteringEpsilon).toString());
+    if (map.contains(NetworkInfo::Key::ClusteringMethod))
+        xml.writeTextElement("clustering-method",
+                             NetworkInfo::clusteringMethodToString(
+                                 NetworkInfo::clusteringMethodFromMap(map)));
+    if (map.contains(NetworkInfo::Key::ClusteringRestarts))
+        xml.writeTextElement("clustering-restarts", map.value(NetworkInfo::Key::ClusteringRestarts).toString());
+    if (map.contains(NetworkInfo::Key::ClusteringTolerance))
+        xml.writeTextElement("clustering-tolerance", map.value(NetworkInfo::Key::ClusteringTolerance).toString());
+    if (map.contains(NetworkInfo::Key::EvaluationInterval))
+        xml.writeTextElement("evaluation-interval", map.value(NetworkInfo::Key::EvaluationInterval).toString());
+    if (map.contains(NetworkInfo::Key::EvaluationMode))
+        xml.writeTextElement("evaluation-mode",
+                             NetworkInfo::evaluationModeToString(
+                                 NetworkInfo::evaluationModeFromMap(map)));
+    if (map.contains(NetworkInfo::Key::EvaluationPrecision))
+        xml.writeTextElement("evaluation-precision",
+                             NetworkInfo::evaluationPrecisionToString(
+                                 NetworkInfo::evaluationPrecisionFromMap(map)));
+
+    if (map.contains(NetworkInfo::Key::KohonenTrainingMode))
+        xml.writeTextElement("kohonen-training-mode",
+                             NetworkInfo::kohonenTrainingModeToString(
+                                 NetworkInfo::kohonenTrainingModeFromMap(map)));
     if (map.contains(NetworkInfo::Key::LearningRate))
         xml.writeTextElement("learning-rate", map.value(NetworkInfo::Key::LearningRate).toString());
+    if (map.contains(NetworkInfo::Key::LearningRateSchedule))
+        xml.writeTextElement("learning-rate-schedule",
+                             NetworkInfo::scheduleToString(
+                                 NetworkInfo::scheduleFromMap(map, NetworkInfo::Key::LearningRateSchedule)));
     if (map.contains(NetworkInfo::Key::MaxEpochs))
         xml.writeTextElement("max-epochs", map.value(NetworkInfo::Key::MaxEpochs).toString());
+    if (map.contains(NetworkInfo::Key::NeighborhoodSchedule))
+        xml.writeTextElement("neighborhood-schedule",
+                             NetworkInfo::scheduleToString(
+                                 NetworkInfo::scheduleFromMap(map, NetworkInfo::Key::NeighborhoodSchedule)));
+    if (map.contains(NetworkInfo::Key::Optimizer))
+        xml.writeTextElement("optimizer",
+                             NetworkInfo::optimizerToString(
+                                 NetworkInfo::optimizerFromMap(map)));
     if (map.contains(NetworkInfo::Key::PauseAfterSample))
         xml.writeTextElement("pause-after-sample", map.value(NetworkInfo::Key::PauseAfterSample).toString());
+    if (map.contains(NetworkInfo::Key::RidgeRegularization))
+        xml.writeTextElement("ridge-regularization", map.value(NetworkInfo::Key::RidgeRegularization).toString());
     if (map.contains(NetworkInfo::Key::SampleSelectionOrder))
         xml.writeTextElement("sample-selection-order",
                              NetworkInfo::sampleSelectionOrderToString(
@@ -579,6 +750,10 @@ bool XmlWorker::writeNetwork(const QString& filePath, const Network& network)
 
     if (map.contains(NetworkInfo::Key::TrainRBFLayer))
         xml.writeTextElement("train-rbf-layer", map.value(NetworkInfo::Key::TrainRBFLayer).toString());
+    if (map.contains(NetworkInfo::Key::TrainingMethod))
+        xml.writeTextElement("training-method",
+                             NetworkInfo::trainingMethodToString(
+                                 NetworkInfo::trainingMethodFromMap(map)));
 
     xml.writeEndElement(); // </training-options>
 
@@ -623,17 +798,16 @@ bool XmlWorker::writeNetwork(const QString& filePath, const Network& network)
                         xml.writeTextElement("sigma",
                                              neuronMap.value(NetworkNeuronInfo::Key::Sigma).toString());
 
-                    auto inputs = neuron->inConnections();
-                    if (inputs.size() > 0) {
+                    int inputs = layer->neuronInWeightCount(j);
+                    if (inputs > 0) {
                         //
                         // <input-weights>
                         //
                         xml.writeStartElement("input-weights");
 
-                        for (int k = 0; k < inputs.size(); k++) {
-                            const auto* conn = neuron->inConnection(k);
-                            xml.writeTextElement("weight", QString::number(conn->weight()));
-                        }
+                        for (int k = 0; k < inputs; k++)
+                            xml.writeTextElement("weight", QString::number(layer->neuronInWeight(j, k)));
+
                         xml.writeEndElement(); // </input-weights>
                     }
                     xml.writeEndElement(); // </neuron>